@@ -86,6 +86,11 @@ GLTexture::GLTexture(byte bpp, GLenum internalFormat, GLenum format, GLenum type
 	_refresh(false),
 	_filter(GL_NEAREST) {
 
+#ifdef USE_GLES
+	_stagingBuffer = 0;
+	_stagingBufferSize = 0;
+#endif
+
 	// Generate the texture ID
 	glGenTextures(1, &_textureName); CHECK_GL_ERROR();
 }
@@ -93,6 +98,10 @@ GLTexture::GLTexture(byte bpp, GLenum internalFormat, GLenum format, GLenum type
 GLTexture::~GLTexture() {
 	// Delete the texture
 	glDeleteTextures(1, &_textureName); CHECK_GL_ERROR();
+
+#ifdef USE_GLES
+	delete[] _stagingBuffer;
+#endif
 }
 
 void GLTexture::refresh() {
@@ -153,47 +162,61 @@ void GLTexture::updateBuffer(const void *buf, int pitch, GLuint x, GLuint y, GLu
 	// Select this OpenGL texture
 	glBindTexture(GL_TEXTURE_2D, _textureName); CHECK_GL_ERROR();
 
-	// Check if the buffer has its data contiguously
-	if ((int)w * _bytesPerPixel == pitch) {
-		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h,
-		                _glFormat, _glType, buf); CHECK_GL_ERROR();
-	} else {
-		// Update the texture row by row
-		const byte *src = (const byte *)buf;
-		GLuint curY = y;
-		GLuint height = h;
-		do {
-			glTexSubImage2D(GL_TEXTURE_2D, 0, x, curY,
-			                w, 1, _glFormat, _glType, src); CHECK_GL_ERROR();
-			curY++;
-			src += pitch;
-		} while (--height);
-	}
+	uploadRect((const byte *)buf, pitch, x, y, w, h);
 
 	// If we're in linear filter mode, repeat the last row/column if the real dimensions
 	// doesn't match the texture dimensions.
 	if (_filter == GL_LINEAR) {
-		if (_realWidth != _textureWidth && x + w == _realWidth) {
-			const byte *src = (const byte *)buf + (w - 1) * _bytesPerPixel;
-			GLuint curY = y;
-			GLuint height = h;
-
-			do {
-				glTexSubImage2D(GL_TEXTURE_2D, 0, x + w,
-						curY, 1, 1, _glFormat, _glType, src); CHECK_GL_ERROR();
-
-				curY++;
-				src += pitch;
-			} while (--height);
-		}
+		if (_realWidth != _textureWidth && x + w == _realWidth)
+			uploadRect((const byte *)buf + (w - 1) * _bytesPerPixel, pitch, x + w, y, 1, h);
 
-		if (_realHeight != _textureHeight && y + h == _realHeight) {
-			glTexSubImage2D(GL_TEXTURE_2D, 0, x, y + h,
-					w, 1, _glFormat, _glType, (const byte *)buf + pitch * (h - 1)); CHECK_GL_ERROR();
-		}
+		if (_realHeight != _textureHeight && y + h == _realHeight)
+			uploadRect((const byte *)buf + pitch * (h - 1), pitch, x, y + h, w, 1);
 	}
 }
 
+// The pixels are uploaded straight from client memory. Streaming them
+// through pixel buffer objects only adds another copy, since they are
+// copied out of the screen surfaces anyway, and measured slower with
+// Mesa's llvmpipe.
+void GLTexture::uploadRect(const byte *src, int pitch, GLuint x, GLuint y, GLuint w, GLuint h) {
+	const uint rowSize = w * _bytesPerPixel;
+
+	// Check if the buffer has its data contiguously
+	if (rowSize == (uint)pitch || h == 1) {
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h,
+		                _glFormat, _glType, src); CHECK_GL_ERROR();
+		return;
+	}
+
+#ifndef USE_GLES
+	// Let OpenGL skip the padding at the end of each row, instead of
+	// issuing one glTexSubImage2D call per row.
+	assert(pitch % _bytesPerPixel == 0);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch / _bytesPerPixel); CHECK_GL_ERROR();
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h,
+	                _glFormat, _glType, src); CHECK_GL_ERROR();
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0); CHECK_GL_ERROR();
+#else
+	// Pack the rows together; copying is far cheaper than one upload per row
+	if (_stagingBufferSize < rowSize * h) {
+		delete[] _stagingBuffer;
+		_stagingBufferSize = rowSize * h;
+		_stagingBuffer = new byte[_stagingBufferSize];
+	}
+
+	byte *dst = _stagingBuffer;
+	for (GLuint i = 0; i < h; i++) {
+		memcpy(dst, src, rowSize);
+		dst += rowSize;
+		src += pitch;
+	}
+
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h,
+	                _glFormat, _glType, _stagingBuffer); CHECK_GL_ERROR();
+#endif
+}
+
 void GLTexture::drawTexture(GLshort x, GLshort y, GLshort w, GLshort h) {
 	// Select this OpenGL texture
 	glBindTexture(GL_TEXTURE_2D, _textureName); CHECK_GL_ERROR();
@@ -114,6 +114,12 @@ public:
 	void setFilter(GLint filter) { _filter = filter; }
 
 private:
+	/**
+	 * Uploads a rect of pixels with a single glTexSubImage2D call, whatever
+	 * the source pitch is.
+	 */
+	void uploadRect(const byte *src, int pitch, GLuint x, GLuint y, GLuint w, GLuint h);
+
 	const byte _bytesPerPixel;
 	const GLenum _internalFormat;
 	const GLenum _glFormat;
@@ -126,6 +132,13 @@ private:
 	GLuint _textureHeight;
 	GLint _filter;
 	bool _refresh;
+
+#ifdef USE_GLES
+	// OpenGL ES lacks GL_UNPACK_ROW_LENGTH, so pitched rects are packed
+	// into this buffer before being uploaded
+	byte *_stagingBuffer;
+	uint _stagingBufferSize;
+#endif
 };
 
 #endif
@@ -46,6 +46,7 @@ OpenGLGraphicsManager::OpenGLGraphicsManager()
 	_screenChangeCount(1 << (sizeof(int) * 8 - 2)), _screenNeedsRedraw(false),
 	_shakePos(0),
 	_overlayVisible(false), _overlayNeedsRedraw(false),
+	_conversionBuffer(0), _conversionBufferSize(0),
 	_transactionMode(kTransactionNone),
 	_cursorNeedsRedraw(false), _cursorPaletteDisabled(true),
 	_cursorVisible(false), _cursorKeyColor(0),
@@ -78,6 +79,8 @@ OpenGLGraphicsManager::~OpenGLGraphicsManager() {
 	delete _gameTexture;
 	delete _overlayTexture;
 	delete _cursorTexture;
+
+	delete[] _conversionBuffer;
 }
 
 //
@@ -684,8 +687,7 @@ void OpenGLGraphicsManager::refreshGameScreen() {
 	int h = _screenDirtyRect.height();
 
 	if (_screenData.format.bytesPerPixel == 1) {
-		// Create a temporary RGB888 surface
-		byte *surface = new byte[w * h * 3];
+		byte *surface = getConversionBuffer(w * h * 3);
 
 		// Convert the paletted buffer to RGB888
 		const byte *src = (byte *)_screenData.pixels + y * _screenData.pitch;
@@ -703,9 +705,6 @@ void OpenGLGraphicsManager::refreshGameScreen() {
 
 		// Update the texture
 		_gameTexture->updateBuffer(surface, w * 3, x, y, w, h);
-
-		// Free the temp surface
-		delete[] surface;
 	} else {
 		// Update the texture
 		_gameTexture->updateBuffer((byte *)_screenData.pixels + y * _screenData.pitch +
@@ -726,8 +725,7 @@ void OpenGLGraphicsManager::refreshOverlay() {
 	int h = _overlayDirtyRect.height();
 
 	if (_overlayData.format.bytesPerPixel == 1) {
-		// Create a temporary RGB888 surface
-		byte *surface = new byte[w * h * 3];
+		byte *surface = getConversionBuffer(w * h * 3);
 
 		// Convert the paletted buffer to RGB888
 		const byte *src = (byte *)_overlayData.pixels + y * _overlayData.pitch;
@@ -745,9 +743,6 @@ void OpenGLGraphicsManager::refreshOverlay() {
 
 		// Update the texture
 		_overlayTexture->updateBuffer(surface, w * 3, x, y, w, h);
-
-		// Free the temp surface
-		delete[] surface;
 	} else {
 		// Update the texture
 		_overlayTexture->updateBuffer((byte *)_overlayData.pixels + y * _overlayData.pitch +
@@ -758,6 +753,15 @@ void OpenGLGraphicsManager::refreshOverlay() {
 	_overlayDirtyRect = Common::Rect();
 }
 
+byte *OpenGLGraphicsManager::getConversionBuffer(uint size) {
+	if (size > _conversionBufferSize) {
+		delete[] _conversionBuffer;
+		_conversionBuffer = new byte[size];
+		_conversionBufferSize = size;
+	}
+	return _conversionBuffer;
+}
+
 void OpenGLGraphicsManager::refreshCursor() {
 	_cursorNeedsRedraw = false;
 
@@ -319,6 +319,19 @@ protected:
 	//
 	virtual bool saveScreenshot(const char *filename);
 
+	/**
+	 * Scratch buffer used to convert paletted screens before uploading
+	 * them. It is kept across frames, so refreshing the screens does not
+	 * allocate memory.
+	 */
+	byte *_conversionBuffer;
+	uint _conversionBufferSize;
+
+	/**
+	 * Returns the conversion buffer, growing it to at least size bytes.
+	 */
+	byte *getConversionBuffer(uint size);
+
 #ifdef USE_OSD
 	/**
 	 * Returns the font used for on screen display
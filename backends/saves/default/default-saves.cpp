@@ -31,16 +31,115 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
 #include "common/zlib.h"
 
 #ifndef _WIN32_WCE
 #include <errno.h>	// for removeSavefile()
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+static const char *const kMetaIndexSuffix = ".metaidx";
+
+enum {
+	kMetaIndexVersion = 3
+};
+
+namespace {
+
+/**
+ * Savefile returned by openForSavingAsync(). The data goes to a temporary
+ * file, which replaces the savefile once the stream is finalized, so a
+ * failed write leaves the previous savefile intact.
+ */
+class AtomicSaveFile : public Common::OutSaveFile {
+	Common::WriteStream *_wrapped;
+	Common::String _filename;
+	Common::String _path;
+	Common::String _tempPath;
+	Common::SaveCompletionProc _proc;
+	void *_refCon;
+	uint32 _openTime;
+	bool _success;
+
+	bool replaceSavefile();
+
+public:
+	AtomicSaveFile(Common::WriteStream *wrapped, const Common::String &filename, const Common::String &path, const Common::String &tempPath, Common::SaveCompletionProc proc, void *refCon)
+		: _wrapped(wrapped), _filename(filename), _path(path), _tempPath(tempPath), _proc(proc), _refCon(refCon), _success(false) {
+		_openTime = g_system->getMillis();
+	}
+
+	~AtomicSaveFile() {
+		finalize();
+	}
+
+	bool err() const { return _wrapped ? _wrapped->err() : !_success; }
+	void clearErr() {
+		if (_wrapped)
+			_wrapped->clearErr();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) { return _wrapped ? _wrapped->write(dataPtr, dataSize) : 0; }
+	bool flush() { return _wrapped ? _wrapped->flush() : false; }
+
+	void finalize() {
+		if (!_wrapped)
+			return;
+
+		_wrapped->finalize();
+		_success = !_wrapped->err();
+
+		// The temporary file has to be closed before it can be renamed
+		delete _wrapped;
+		_wrapped = 0;
+
+		if (_success)
+			_success = replaceSavefile();
+
+		if (!_success) {
+			warning("Could not write savefile '%s'", _path.c_str());
+			remove(_tempPath.c_str());
+		}
+
+		debug(1, "Saved '%s' in %d ms", _filename.c_str(), g_system->getMillis() - _openTime);
+
+		if (_proc)
+			_proc(_filename, _success, _refCon);
+	}
+};
+
+bool AtomicSaveFile::replaceSavefile() {
+	if (rename(_tempPath.c_str(), _path.c_str()) == 0)
+		return true;
+
+	// rename does not replace existing files on all systems. Move the old
+	// savefile aside and only remove it once the new one is in place, so
+	// that it can be restored if the second rename fails.
+	Common::String backupPath = _path + ".bak";
+	remove(backupPath.c_str());
+	bool backup = (rename(_path.c_str(), backupPath.c_str()) == 0);
+
+	if (rename(_tempPath.c_str(), _path.c_str()) == 0) {
+		remove(backupPath.c_str());
+		return true;
+	}
+
+	if (backup)
+		rename(backupPath.c_str(), _path.c_str());
+	return false;
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+} // End of anonymous namespace
+
+DefaultSaveFileManager::DefaultSaveFileManager()
+	: _metaIndexLoaded(false), _metaIndexDirty(false) {
+}
+
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath)
+	: _metaIndexLoaded(false), _metaIndexDirty(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
@@ -70,6 +169,9 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 
 	if (dir.listMatchingMembers(savefiles, search) > 0) {
 		for (Common::ArchiveMemberList::const_iterator file = savefiles.begin(); file != savefiles.end(); ++file) {
+			// Metadata indices are no savefiles of their own
+			if ((*file)->getName().hasSuffix(kMetaIndexSuffix))
+				continue;
 			results.push_back((*file)->getName());
 		}
 	}
@@ -78,6 +180,11 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	Common::SeekableReadStream *sf = openRawForLoading(filename);
+	return Common::wrapCompressedReadStream(sf);
+}
+
+Common::SeekableReadStream *DefaultSaveFileManager::openRawForLoading(const Common::String &filename) {
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -92,12 +199,12 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 		return 0;
 
 	// Open the file for reading
-	Common::SeekableReadStream *sf = file.createReadStream();
-
-	return Common::wrapCompressedReadStream(sf);
+	return file.createReadStream();
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	invalidateCachedMetaInfo(filename);
+
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -115,7 +222,35 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	return compress ? Common::wrapCompressedWriteStream(sf) : sf;
 }
 
+Common::OutSaveFile *DefaultSaveFileManager::openForSavingAsync(const Common::String &filename, Common::SaveCompletionProc proc, void *refCon, bool compress) {
+	invalidateCachedMetaInfo(filename);
+
+	// Ensure that the savepath is valid. If not, generate an appropriate error.
+	Common::String savePathName = getSavePath();
+	checkPath(Common::FSNode(savePathName));
+	if (getError().getCode() != Common::kNoError)
+		return 0;
+
+	// recreate FSNode since checkPath may have changed/created the directory
+	Common::FSNode savePath(savePathName);
+
+	Common::FSNode file = savePath.getChild(filename);
+	Common::FSNode tempFile = savePath.getChild(filename + ".tmp");
+
+	// Open the temporary file for writing
+	Common::WriteStream *sf = tempFile.createWriteStream();
+	if (!sf)
+		return 0;
+
+	if (compress)
+		sf = Common::wrapCompressedWriteStream(sf);
+
+	return new AtomicSaveFile(sf, filename, file.getPath(), tempFile.getPath(), proc, refCon);
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	invalidateCachedMetaInfo(filename);
+
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
 	if (getError().getCode() != Common::kNoError)
@@ -143,6 +278,180 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	}
 }
 
+Common::SeekableReadStream *DefaultSaveFileManager::openCachedMetaInfo(const Common::String &target, int slot) {
+	loadMetaIndex(target);
+
+	MetaIndex::iterator entry = _metaIndex.find(slot);
+	if (entry == _metaIndex.end())
+		return 0;
+
+	// The savefile may have been replaced outside of ScummVM
+	if (getSavefileSize(entry->_value.savefile) != entry->_value.savefileSize) {
+		_metaIndex.erase(entry);
+		_metaIndexDirty = true;
+		return 0;
+	}
+
+	const Common::Array<byte> &data = entry->_value.data;
+	byte *copy = (byte *)malloc(data.size());
+	if (!copy)
+		return 0;
+	if (!data.empty())
+		memcpy(copy, &data[0], data.size());
+
+	return new Common::MemoryReadStream(copy, data.size(), DisposeAfterUse::YES);
+}
+
+void DefaultSaveFileManager::storeCachedMetaInfo(const Common::String &target, int slot, const Common::String &savefile, const byte *data, uint32 size) {
+	// Writing or removing a savefile only looks at the index of the target
+	// its name starts with, so entries of other savefiles would go stale
+	if (!savefile.hasPrefix(target + "."))
+		return;
+
+	int32 savefileSize = getSavefileSize(savefile);
+	if (savefileSize < 0)
+		return;
+
+	loadMetaIndex(target);
+
+	MetaIndexEntry &entry = _metaIndex[slot];
+	entry.savefile = savefile;
+	entry.savefileSize = savefileSize;
+	entry.data.resize(size);
+	if (size)
+		memcpy(&entry.data[0], data, size);
+
+	_metaIndexDirty = true;
+}
+
+void DefaultSaveFileManager::flushCachedMetaInfos() {
+	if (!_metaIndexDirty)
+		return;
+
+	_metaIndexDirty = false;
+
+	// Replaced atomically, so an interrupted write cannot leave a
+	// truncated index behind
+	Common::OutSaveFile *out = openForSavingAsync(getMetaIndexName(_metaIndexTarget));
+	if (!out)
+		return;
+
+	out->writeUint32BE(MKTAG('S', 'M', 'I', 'X'));
+	out->writeUint32LE(kMetaIndexVersion);
+	out->writeUint32LE(_metaIndex.size());
+
+	for (MetaIndex::const_iterator entry = _metaIndex.begin(); entry != _metaIndex.end(); ++entry) {
+		const MetaIndexEntry &value = entry->_value;
+		out->writeSint32LE(entry->_key);
+		out->writeUint16LE(value.savefile.size());
+		out->writeString(value.savefile);
+		out->writeSint32LE(value.savefileSize);
+		out->writeUint32LE(value.data.size());
+		if (!value.data.empty())
+			out->write(&value.data[0], value.data.size());
+	}
+
+	out->finalize();
+	delete out;
+}
+
+Common::String DefaultSaveFileManager::getMetaIndexName(const Common::String &target) {
+	return target + kMetaIndexSuffix;
+}
+
+int32 DefaultSaveFileManager::getSavefileSize(const Common::String &filename) {
+	Common::SeekableReadStream *sf = openRawForLoading(filename);
+	int32 size = sf ? sf->size() : -1;
+	delete sf;
+	return size;
+}
+
+void DefaultSaveFileManager::loadMetaIndex(const Common::String &target) {
+	if (_metaIndexLoaded && _metaIndexTarget == target)
+		return;
+
+	flushCachedMetaInfos();
+
+	_metaIndexTarget = target;
+	_metaIndexLoaded = true;
+	_metaIndex.clear();
+
+	Common::SeekableReadStream *sf = openRawForLoading(getMetaIndexName(target));
+	if (!sf)
+		return;
+
+	Common::InSaveFile *in = Common::wrapCompressedReadStream(sf);
+
+	// An index of another version is simply rebuilt from scratch
+	if (in->readUint32BE() != MKTAG('S', 'M', 'I', 'X') || in->readUint32LE() != kMetaIndexVersion) {
+		delete in;
+		return;
+	}
+
+	uint32 count = in->readUint32LE();
+	while (count-- && !in->err() && !in->eos()) {
+		int slot = in->readSint32LE();
+		MetaIndexEntry &entry = _metaIndex[slot];
+
+		for (uint16 length = in->readUint16LE(); length && !in->eos(); --length)
+			entry.savefile += (char)in->readByte();
+		entry.savefileSize = in->readSint32LE();
+
+		uint32 size = in->readUint32LE();
+		if (size > (uint32)(in->size() - in->pos()))
+			break;
+
+		entry.data.resize(size);
+		if (size)
+			in->read(&entry.data[0], size);
+	}
+
+	if (in->err() || in->eos()) {
+		warning("Metadata index of '%s' is corrupt, rebuilding it", target.c_str());
+		_metaIndex.clear();
+	}
+
+	delete in;
+}
+
+void DefaultSaveFileManager::invalidateCachedMetaInfo(const Common::String &filename) {
+	if (filename.hasSuffix(kMetaIndexSuffix))
+		return;
+
+	// Only savefiles named "<target>.<suffix>" are cached, see
+	// storeCachedMetaInfo(). The target is taken from the name rather than
+	// the active domain, so this also works from the launcher.
+	const char *dot = strchr(filename.c_str(), '.');
+	if (!dot || dot == filename.c_str())
+		return;
+
+	const Common::String target(filename.c_str(), dot);
+	if (!_metaIndexLoaded || _metaIndexTarget != target) {
+		// Avoid loading the index of targets without one
+		Common::SeekableReadStream *sf = openRawForLoading(getMetaIndexName(target));
+		if (!sf)
+			return;
+		delete sf;
+	}
+
+	loadMetaIndex(target);
+
+	// Only the entry taken from this very file is affected, so writing
+	// other files such as high scores keeps the index intact
+	bool dropped = false;
+	for (MetaIndex::iterator entry = _metaIndex.begin(); entry != _metaIndex.end(); ++entry) {
+		if (entry->_value.savefile == filename) {
+			_metaIndex.erase(entry);
+			dropped = true;
+		}
+	}
+
+	if (dropped) {
+		_metaIndexDirty = true;
+		flushCachedMetaInfos();
+	}
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
@@ -27,6 +27,7 @@
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
 
 /**
  * Provides a default savefile manager implementation for common platforms.
@@ -39,9 +40,56 @@ public:
 	virtual Common::StringArray listSavefiles(const Common::String &pattern);
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
+	virtual Common::OutSaveFile *openForSavingAsync(const Common::String &filename, Common::SaveCompletionProc proc = 0, void *refCon = 0, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
 
+	virtual Common::SeekableReadStream *openCachedMetaInfo(const Common::String &target, int slot);
+	virtual void storeCachedMetaInfo(const Common::String &target, int slot, const Common::String &savefile, const byte *data, uint32 size);
+	virtual void flushCachedMetaInfos();
+
 protected:
+	/**
+	 * Get the name of the file holding the metadata index of a target.
+	 */
+	static Common::String getMetaIndexName(const Common::String &target);
+
+	/**
+	 * Open a file in the savegame directory without decompressing it.
+	 */
+	Common::SeekableReadStream *openRawForLoading(const Common::String &filename);
+
+	/**
+	 * Get the size of a file in the savegame directory, or -1 if it does
+	 * not exist.
+	 */
+	int32 getSavefileSize(const Common::String &filename);
+
+	/**
+	 * Load the metadata index of the given target, unless it is already
+	 * loaded. Changes to a previously loaded index are written out first.
+	 */
+	void loadMetaIndex(const Common::String &target);
+
+	/**
+	 * Drop the cached metadata taken from the given savefile. The target
+	 * is derived from the filename, files that no entry was taken from are
+	 * left alone.
+	 */
+	void invalidateCachedMetaInfo(const Common::String &filename);
+
+	struct MetaIndexEntry {
+		Common::String savefile;	///< the savefile the data was taken from
+		int32 savefileSize;			///< its size on disk at that time
+		Common::Array<byte> data;
+	};
+
+	typedef Common::HashMap<int, MetaIndexEntry> MetaIndex;
+
+	Common::String _metaIndexTarget;
+	MetaIndex _metaIndex;
+	bool _metaIndexLoaded;
+	bool _metaIndexDirty;
+
 	/**
 	 * Get the path to the savegame directory.
 	 * Should only be used internally since some platforms
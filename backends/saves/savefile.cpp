@@ -26,6 +26,55 @@
 
 namespace Common {
 
+namespace {
+
+/**
+ * Wrapper notifying a completion callback once the wrapped savefile has
+ * been finalized. Used by the synchronous fallback of openForSavingAsync().
+ */
+class CompletionNotifyingSaveFile : public OutSaveFile {
+	OutSaveFile *_wrapped;
+	String _name;
+	SaveCompletionProc _proc;
+	void *_refCon;
+	bool _finalized;
+
+public:
+	CompletionNotifyingSaveFile(OutSaveFile *wrapped, const String &name, SaveCompletionProc proc, void *refCon)
+		: _wrapped(wrapped), _name(name), _proc(proc), _refCon(refCon), _finalized(false) {}
+
+	~CompletionNotifyingSaveFile() {
+		finalize();
+		delete _wrapped;
+	}
+
+	bool err() const { return _wrapped->err(); }
+	void clearErr() { _wrapped->clearErr(); }
+
+	uint32 write(const void *dataPtr, uint32 dataSize) { return _wrapped->write(dataPtr, dataSize); }
+	bool flush() { return _wrapped->flush(); }
+
+	void finalize() {
+		if (_finalized)
+			return;
+
+		_finalized = true;
+		_wrapped->finalize();
+		_proc(_name, !_wrapped->err(), _refCon);
+	}
+};
+
+} // End of anonymous namespace
+
+OutSaveFile *SaveFileManager::openForSavingAsync(const String &name, SaveCompletionProc proc, void *refCon, bool compress) {
+	OutSaveFile *outFile = openForSaving(name, compress);
+
+	if (!outFile || !proc)
+		return outFile;
+
+	return new CompletionNotifyingSaveFile(outFile, name, proc, refCon);
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename) {
 	InSaveFile *inFile = 0;
 	OutSaveFile *outFile = 0;
@@ -47,6 +47,7 @@
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
+#include "common/savefile.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
@@ -228,6 +229,10 @@ static Common::Error runGame(const EnginePlugin *plugin, OSystem &system, const
 	// Run the engine
 	Common::Error result = engine->run();
 
+	// Savefiles may still be written in the background. Finish them while
+	// the engine, which may get notified about them, is still around.
+	system.getSavefileManager()->waitForPendingSaves();
+
 	// Inform backend that the engine finished
 	system.engineDone();
 
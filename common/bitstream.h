@@ -67,6 +67,9 @@ public:
 	/** Add a bit to the value x, making it an n+1-bit value. */
 	virtual void addBit(uint32 &x, uint32 n) = 0;
 
+	/** Does the stream hand out the bits in the order of MSB to LSB? */
+	virtual bool isMSB2LSB() const = 0;
+
 protected:
 	BitStream() {
 	}
@@ -76,20 +79,32 @@ protected:
  * A template implementing a bit stream for different data memory layouts.
  *
  * Such a bit stream reads valueBits-wide values from the data stream and
- * gives access to their bits, one at a time.
+ * gives access to their bits.
  *
  * For example, a bit stream with the layout parameters 32, true, false
- * for valueBits, isLE and isMSB2LSB, reads 32bit little-endian values
+ * for valueBits, isLE and MSB2LSB, reads 32bit little-endian values
  * from the data stream and hands out the bits in the order of LSB to MSB.
+ *
+ * The bits of as many whole values as fit are kept in a 32bit cache, so
+ * that multi-bit reads, peeks and skips do not need to go through the
+ * data stream bit by bit. As a consequence, the position of the data
+ * stream is ahead of the bit stream's position.
  */
-template<int valueBits, bool isLE, bool isMSB2LSB>
+template<int valueBits, bool isLE, bool MSB2LSB>
 class BitStreamImpl : public BitStream {
 private:
 	SeekableReadStream *_stream; ///< The input stream.
 	bool _disposeAfterUse;       ///< Should we delete the stream on destruction?
 
-	uint32 _value;   ///< Current value.
-	uint8  _inValue; ///< Position within the current value.
+	uint32 _value;   ///< Bits read from the stream, but not consumed yet.
+	uint8  _inValue; ///< Number of bits in the cache.
+
+	uint32 _lookAhead;    ///< Data value read in advance by peekBits().
+	bool   _hasLookAhead; ///< Is there a data value in _lookAhead?
+
+	uint32 _pos;     ///< Position in bits.
+	uint32 _dataPos; ///< Position of the input stream in bits.
+	uint32 _size;    ///< Size in bits.
 
 	/** Read a data value. */
 	inline uint32 readData() {
@@ -113,35 +128,90 @@ private:
 		return 0;
 	}
 
+	/** Is there another data value left? */
+	inline bool hasValue() const {
+		return _hasLookAhead || (_dataPos + valueBits <= _size);
+	}
+
 	/** Read the next data value. */
-	inline void readValue() {
-		if ((size() - pos()) < valueBits)
+	inline uint32 readValue() {
+		if (_hasLookAhead) {
+			_hasLookAhead = false;
+			return _lookAhead;
+		}
+
+		if (_dataPos + valueBits > _size)
 			error("BitStreamImpl::readValue(): End of bit stream reached");
 
-		_value = readData();
+		uint32 value = readData();
 		if (_stream->err() || _stream->eos())
 			error("BitStreamImpl::readValue(): Read error");
 
-		// If we're reading the bits MSB first, we need to shift the value to that position
-		if (isMSB2LSB)
-			_value <<= 32 - valueBits;
+		_dataPos += valueBits;
+		return value;
+	}
+
+	/** Fill the cache with as many data values as fit. */
+	inline void fillCache() {
+		while ((_inValue <= 32 - valueBits) && hasValue()) {
+			uint32 value = readValue();
+
+			// If we're reading the bits MSB first, the cached bits start at the MSB
+			if (MSB2LSB)
+				_value |= value << (32 - valueBits - _inValue);
+			else
+				_value |= value << _inValue;
+
+			_inValue += valueBits;
+		}
+	}
+
+	/** Set up the positions from the input stream. */
+	void init() {
+		_pos     = _stream->pos() * 8;
+		_dataPos = _pos;
+		_size    = (_stream->size() & ~((uint32) ((valueBits >> 3) - 1))) * 8;
+	}
+
+	/** Take 1 to 32 bits out of the cache, which has to hold them. */
+	inline uint32 takeBits(uint8 n) {
+		uint32 v;
+
+		if (MSB2LSB) {
+			v = _value >> (32 - n);
+			_value = (n < 32) ? (_value << n) : 0;
+		} else {
+			v = (n < 32) ? (_value & ((1U << n) - 1)) : _value;
+			_value = (n < 32) ? (_value >> n) : 0;
 		}
 
+		_inValue -= n;
+		_pos     += n;
+
+		return v;
+	}
+
 public:
 	/** Create a bit stream using this input data stream and optionally delete it on destruction. */
 	BitStreamImpl(SeekableReadStream *stream, bool disposeAfterUse = false) :
-		_stream(stream), _disposeAfterUse(disposeAfterUse), _value(0), _inValue(0) {
+		_stream(stream), _disposeAfterUse(disposeAfterUse), _value(0), _inValue(0),
+		_lookAhead(0), _hasLookAhead(false) {
 
 		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
-			error("BitStreamImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, isMSB2LSB);
+			error("BitStreamImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, MSB2LSB);
+
+		init();
 	}
 
 	/** Create a bit stream using this input data stream. */
 	BitStreamImpl(SeekableReadStream &stream) :
-		_stream(&stream), _disposeAfterUse(false), _value(0), _inValue(0) {
+		_stream(&stream), _disposeAfterUse(false), _value(0), _inValue(0),
+		_lookAhead(0), _hasLookAhead(false) {
 
 		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
-			error("BitStreamImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, isMSB2LSB);
+			error("BitStreamImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, MSB2LSB);
+
+		init();
 	}
 
 	~BitStreamImpl() {
@@ -152,26 +222,13 @@ public:
 	/** Read a bit from the bit stream. */
 	uint32 getBit() {
 		// Check if we need the next value
-		if (_inValue == 0)
-			readValue();
-
-		// Get the current bit
-		int b = 0;
-		if (isMSB2LSB)
-			b = ((_value & 0x80000000) == 0) ? 0 : 1;
-		else
-			b = ((_value & 1) == 0) ? 0 : 1;
-
-		// Shift to the next bit
-		if (isMSB2LSB)
-			_value <<= 1;
-		else
-			_value >>= 1;
-
-		// Increase the position within the current value
-		_inValue = (_inValue + 1) % valueBits;
+		if (_inValue == 0) {
+			fillCache();
+			if (_inValue == 0)
+				error("BitStreamImpl::getBit(): End of bit stream reached");
+		}
 
-		return b;
+		return takeBits(1);
 	}
 
 	/**
@@ -191,52 +248,72 @@ public:
 		if (n > 32)
 			error("BitStreamImpl::getBits(): Too many bits requested to be read");
 
-		// Read the number of bits
-		uint32 v = 0;
+		if (n <= _inValue)
+			return takeBits(n);
 
-		if (isMSB2LSB) {
-			while (n-- > 0)
-				v = (v << 1) | getBit();
-		} else {
-			for (uint32 i = 0; i < n; i++)
-				v = (v >> 1) | (((uint32) getBit()) << 31);
+		// Take what is left in the cache and the rest from the next values
+		uint8 first = _inValue;
+		uint8 rest  = n - first;
+		uint32 v = first ? takeBits(first) : 0;
 
-			v >>= (32 - n);
-		}
+		fillCache();
+		if (_inValue < rest)
+			error("BitStreamImpl::getBits(): End of bit stream reached");
 
-		return v;
+		uint32 w = takeBits(rest);
+
+		if (MSB2LSB)
+			return first ? ((v << rest) | w) : w;
+		else
+			return v | (w << first);
 	}
 
 	/** Read a bit from the bit stream, without changing the stream's position. */
 	uint32 peekBit() {
-		uint32 value   = _value;
-		uint8  inValue = _inValue;
-		uint32 curPos  = _stream->pos();
-
-		uint32 v = getBit();
-
-		_stream->seek(curPos);
-		_inValue = inValue;
-		_value   = value;
-
-		return v;
+		return peekBits(1);
 	}
 
 	/**
 	 * Read a multi-bit value from the bit stream, without changing the stream's position.
 	 *
-	 * The bit order is the same as in getBits().
+	 * The bit order is the same as in getBits(). Bits past the end of the
+	 * stream are read as 0.
 	 */
 	uint32 peekBits(uint8 n) {
-		uint32 value   = _value;
-		uint8  inValue = _inValue;
-		uint32 curPos  = _stream->pos();
+		if (n == 0)
+			return 0;
 
-		uint32 v = getBits(n);
+		if (n > 32)
+			error("BitStreamImpl::peekBits(): Too many bits requested to be read");
+
+		if (n > _inValue)
+			fillCache();
+
+		uint32 v;
+		if (MSB2LSB)
+			v = _value >> (32 - n);
+		else
+			v = (n < 32) ? (_value & ((1U << n) - 1)) : _value;
+
+		if (n <= _inValue)
+			return v;
+
+		// The cache can't hold the next value yet, so add its bits to the
+		// peeked ones directly
+		if (!_hasLookAhead && hasValue()) {
+			_lookAhead    = readValue();
+			_hasLookAhead = true;
+		}
 
-		_stream->seek(curPos);
-		_inValue = inValue;
-		_value   = value;
+		if (_hasLookAhead) {
+			if (MSB2LSB) {
+				v |= ((_lookAhead << (32 - valueBits)) >> _inValue) >> (32 - n);
+			} else {
+				v |= _lookAhead << _inValue;
+				if (n < 32)
+					v &= (1U << n) - 1;
+			}
+		}
 
 		return v;
 	}
@@ -256,7 +333,7 @@ public:
 		if (n >= 32)
 			error("BitStreamImpl::addBit(): Too many bits requested to be read");
 
-		if (isMSB2LSB)
+		if (MSB2LSB)
 			x = (x << 1) | getBit();
 		else
 			x = (x & ~(1 << n)) | (getBit() << n);
@@ -266,32 +343,40 @@ public:
 	void rewind() {
 		_stream->seek(0);
 
-		_value   = 0;
-		_inValue = 0;
+		_value        = 0;
+		_inValue      = 0;
+		_hasLookAhead = false;
+		_pos          = 0;
+		_dataPos      = 0;
 	}
 
 	/** Skip the specified amount of bits. */
 	void skip(uint32 n) {
-		while (n-- > 0)
-			getBit();
+		while (n > 32) {
+			getBits(32);
+			n -= 32;
+		}
+
+		getBits(n);
 	}
 
 	/** Return the stream position in bits. */
 	uint32 pos() const {
-		if (_stream->pos() == 0)
-			return 0;
-
-		uint32 p = (_inValue == 0) ? _stream->pos() : ((_stream->pos() - 1) & ~((uint32) ((valueBits >> 3) - 1)));
-		return p * 8 + _inValue;
+		return _pos;
 	}
 
 	/** Return the stream size in bits. */
 	uint32 size() const {
-		return (_stream->size() & ~((uint32) ((valueBits >> 3) - 1))) * 8;
+		return _size;
 	}
 
 	bool eos() const {
-		return _stream->eos() || (pos() >= size());
+		return _pos >= _size;
+	}
+
+	/** Does the stream hand out the bits in the order of MSB to LSB? */
+	bool isMSB2LSB() const {
+		return MSB2LSB;
 	}
 };
 
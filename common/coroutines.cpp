@@ -94,15 +94,10 @@ CoroBaseContext::~CoroBaseContext() {
 //--------------------- Scheduler Class ------------------------
 
 CoroutineScheduler::CoroutineScheduler() {
-	processList = NULL;
 	pFreeProcesses = NULL;
 	pCurrent = NULL;
 
-#ifdef DEBUG
-	// diagnostic process counters
-	numProcs = 0;
-	maxProcs = 0;
-#endif
+	memset(&_stats, 0, sizeof(_stats));
 
 	pRCfunction = NULL;
 	pidCounter = 0;
@@ -123,37 +118,75 @@ CoroutineScheduler::~CoroutineScheduler() {
 		pProc = pProc->pNext;
 	}
 
-	free(processList);
-	processList = NULL;
+	for (uint i = 0; i < _processBlocks.size(); i++)
+		free(_processBlocks[i]);
+	_processBlocks.clear();
 
 	delete active;
 	active = 0;
 
 	// Clear the event list
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i)
-		delete *i;
+	for (EventMap::iterator i = _events.begin(); i != _events.end(); ++i)
+		delete i->_value;
 }
 
-void CoroutineScheduler::reset() {
-#ifdef DEBUG
-	// clear number of process in use
-	numProcs = 0;
-#endif
+void CoroutineScheduler::allocateProcessBlock() {
+	PROCESS *block = (PROCESS *)calloc(CORO_NUM_PROCESS, sizeof(PROCESS));
 
-	if (processList == NULL) {
-		// first time - allocate memory for process list
-		processList = (PROCESS *)calloc(CORO_MAX_PROCESSES, sizeof(PROCESS));
+	// make sure memory allocated
+	if (block == NULL) {
+		error("Cannot allocate memory for process data");
+	}
 
-		// make sure memory allocated
-		if (processList == NULL) {
-			error("Cannot allocate memory for process data");
-		}
+	// fill with garbage
+	memset(block, 'S', CORO_NUM_PROCESS * sizeof(PROCESS));
+
+	_processBlocks.push_back(block);
+	_stats.poolSize += CORO_NUM_PROCESS;
+
+	linkProcessBlock(block);
+}
+
+void CoroutineScheduler::linkProcessBlock(PROCESS *block) {
+	// link all processes of the block in front of the free list
+	for (int i = 0; i < CORO_NUM_PROCESS; i++) {
+		block[i].pNext = (i == CORO_NUM_PROCESS - 1) ? pFreeProcesses : block + i + 1;
+		block[i].pPrevious = (i == 0) ? NULL : block + i - 1;
+	}
+
+	if (pFreeProcesses)
+		pFreeProcesses->pPrevious = block + CORO_NUM_PROCESS - 1;
+	pFreeProcesses = block;
+}
 
-		// fill with garbage
-		memset(processList, 'S', CORO_MAX_PROCESSES * sizeof(PROCESS));
+bool CoroutineScheduler::isValidProcess(const PROCESS *pProc) const {
+	for (uint i = 0; i < _processBlocks.size(); i++) {
+		if (pProc >= _processBlocks[i] && pProc < _processBlocks[i] + CORO_NUM_PROCESS)
+			return true;
 	}
 
+	return false;
+}
+
+void CoroutineScheduler::addPid(uint32 pid) {
+	_pidCounts[pid]++;
+
+	if (++_stats.numProcesses > _stats.maxProcesses)
+		_stats.maxProcesses = _stats.numProcesses;
+}
+
+void CoroutineScheduler::removePid(uint32 pid) {
+	PidCountMap::iterator i = _pidCounts.find(pid);
+	assert(i != _pidCounts.end());
+
+	if (--i->_value == 0)
+		_pidCounts.erase(i);
+
+	assert(_stats.numProcesses > 0);
+	--_stats.numProcesses;
+}
+
+void CoroutineScheduler::reset() {
 	// Kill all running processes (i.e. free memory allocated for their state).
 	PROCESS *pProc = active->pNext;
 	while (pProc != NULL) {
@@ -165,21 +198,23 @@ void CoroutineScheduler::reset() {
 
 	// no active processes
 	pCurrent = active->pNext = NULL;
+	_pidCounts.clear();
+	_stats.numProcesses = 0;
 
-	// place first process on free list
-	pFreeProcesses = processList;
-
-	// link all other processes after first
-	for (int i = 1; i <= CORO_NUM_PROCESS; i++) {
-		processList[i - 1].pNext = (i == CORO_NUM_PROCESS) ? NULL : processList + i;
-		processList[i - 1].pPrevious = (i == 1) ? active : processList + (i - 2);
-	}
+	// place all processes on the free list, allocating the first block
+	// on the first call
+	pFreeProcesses = NULL;
+	if (_processBlocks.empty())
+		allocateProcessBlock();
+	else
+		for (uint i = 0; i < _processBlocks.size(); i++)
+			linkProcessBlock(_processBlocks[i]);
 }
 
 
 #ifdef DEBUG
 void CoroutineScheduler::printStats() {
-	debug("%i process of %i used", maxProcs, CORO_NUM_PROCESS);
+	debug("%i process of %i used", _stats.maxProcesses, _stats.poolSize);
 }
 #endif
 
@@ -203,22 +238,26 @@ void CoroutineScheduler::checkStack() {
 	}
 
 	// Make sure all processes are accounted for
-	for (int idx = 0; idx < CORO_NUM_PROCESS; idx++) {
-		bool found = false;
-		for (Common::List<PROCESS *>::iterator i = pList.begin(); i != pList.end(); ++i) {
-			PROCESS *pTemp = *i;
-			if (*i == &processList[idx]) {
-				found = true;
-				break;
+	for (uint block = 0; block < _processBlocks.size(); block++) {
+		for (int idx = 0; idx < CORO_NUM_PROCESS; idx++) {
+			bool found = false;
+			for (Common::List<PROCESS *>::iterator i = pList.begin(); i != pList.end(); ++i) {
+				if (*i == &_processBlocks[block][idx]) {
+					found = true;
+					break;
+				}
 			}
-		}
 
-		assert(found);
+			assert(found);
+		}
 	}
 }
 #endif
 
 void CoroutineScheduler::schedule() {
+	uint32 startTime = g_system->getMillis();
+	uint numDispatched = 0;
+
 	// start dispatching active process list
 	PROCESS *pNext;
 	PROCESS *pProc = active->pNext;
@@ -227,6 +266,7 @@ void CoroutineScheduler::schedule() {
 
 		if (--pProc->sleepTime <= 0) {
 			// process is ready for dispatch, activate it
+			numDispatched++;
 			pCurrent = pProc;
 			pProc->coroAddr(pProc->state, pProc->param);
 
@@ -247,13 +287,34 @@ void CoroutineScheduler::schedule() {
 	}
 
 	// Disable any events that were pulsed
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pulsing) {
+	for (uint i = 0; i < _pulsedEvents.size(); i++) {
+		EVENT *evt = getEvent(_pulsedEvents[i]);
+		if (evt && evt->pulsing) {
 			evt->pulsing = evt->signalled = false;
 		}
 	}
+	_pulsedEvents.clear();
+
+	uint32 time = g_system->getMillis() - startTime;
+	_stats.numDispatched = numDispatched;
+	_stats.numTicks++;
+	_stats.processTime += time;
+	_stats.maxProcessTime = MAX(_stats.maxProcessTime, time);
+}
+
+CoroutineScheduler::Stats CoroutineScheduler::getStats() const {
+	Stats stats = _stats;
+	stats.numSleeping = 0;
+	stats.numWaiting = 0;
+
+	for (const PROCESS *pProc = active->pNext; pProc != NULL; pProc = pProc->pNext) {
+		if (pProc->sleepTime > 1)
+			stats.numSleeping++;
+		if (pProc->pidWaiting[0] != 0)
+			stats.numWaiting++;
+	}
+
+	return stats;
 }
 
 void CoroutineScheduler::rescheduleAll() {
@@ -347,7 +408,7 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
+		bool processFound;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -364,12 +425,12 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
 		// Check to see if a process or event with the given Id exists
-		_ctx->pProcess = getProcess(pid);
-		_ctx->pEvent = !_ctx->pProcess ? getEvent(pid) : NULL;
+		_ctx->processFound = processExists(pid);
+		_ctx->pEvent = !_ctx->processFound ? getEvent(pid) : NULL;
 
 		// If there's no active process or event, presume it's a process that's finished,
 		// so the waiting can immediately exit
-		if ((_ctx->pProcess == NULL) && (_ctx->pEvent == NULL)) {
+		if (!_ctx->processFound && (_ctx->pEvent == NULL)) {
 			if (expired)
 				*expired = false;
 			break;
@@ -407,7 +468,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		bool signalled;
 		bool pidSignalled;
 		int i;
-		PROCESS *pProcess;
+		bool processFound;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -427,11 +488,11 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		_ctx->signalled = bWaitAll;
 
 		for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
-			_ctx->pProcess = getProcess(pidList[_ctx->i]);
-			_ctx->pEvent = !_ctx->pProcess ? getEvent(pidList[_ctx->i]) : NULL;
+			_ctx->processFound = processExists(pidList[_ctx->i]);
+			_ctx->pEvent = !_ctx->processFound ? getEvent(pidList[_ctx->i]) : NULL;
 
 			// Determine the signalled state
-			_ctx->pidSignalled = (_ctx->pProcess) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
+			_ctx->pidSignalled = _ctx->processFound || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
 
 			if (bWaitAll && !_ctx->pidSignalled)
 				_ctx->signalled = false;
@@ -445,7 +506,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 			for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
 				_ctx->pEvent = getEvent(pidList[_ctx->i]);
 
-				if (!_ctx->pEvent->manualReset)
+				if (_ctx->pEvent && !_ctx->pEvent->manualReset)
 					_ctx->pEvent->signalled = false;
 			}
 
@@ -490,18 +551,13 @@ void CoroutineScheduler::sleep(CORO_PARAM, uint32 duration) {
 PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const void *pParam, int sizeParam) {
 	PROCESS *pProc;
 
+	// grow the pool when there is no free process left
+	if (pFreeProcesses == NULL)
+		allocateProcessBlock();
+
 	// get a free process
 	pProc = pFreeProcesses;
 
-	// trap no free process
-	assert(pProc != NULL); // Out of processes
-
-#ifdef DEBUG
-	// one more process in use
-	if (++numProcs > maxProcs)
-		maxProcs = numProcs;
-#endif
-
 	// get link to next free process
 	pFreeProcesses = pProc->pNext;
 	if (pFreeProcesses)
@@ -538,6 +594,7 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// set new process id
 	pProc->pid = pid;
+	addPid(pid);
 
 	// set new process specific info
 	if (sizeParam) {
@@ -562,16 +619,13 @@ uint32 CoroutineScheduler::createProcess(CORO_ADDR coroAddr, const void *pParam)
 
 void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 	// make sure a valid process pointer
-	assert(pKillProc >= processList && pKillProc <= processList + CORO_NUM_PROCESS - 1);
+	assert(isValidProcess(pKillProc));
 
 	// can not kill the current process using killProcess !
 	assert(pCurrent != pKillProc);
 
-#ifdef DEBUG
 	// one less process in use
-	--numProcs;
-	assert(numProcs >= 0);
-#endif
+	removePid(pKillProc->pid);
 
 	// Free process' resources
 	if (pRCfunction != NULL)
@@ -603,7 +657,7 @@ int CoroutineScheduler::getCurrentPID() const {
 	PROCESS *pProc = pCurrent;
 
 	// make sure a valid process pointer
-	assert(pProc >= processList && pProc <= processList + CORO_NUM_PROCESS - 1);
+	assert(isValidProcess(pProc));
 
 	// return processes PID
 	return pProc->pid;
@@ -621,6 +675,7 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 			if (pProc != pCurrent) {
 				// kill this process
 				numKilled++;
+				removePid(pProc->pid);
 
 				// Free the process' resources
 				if (pRCfunction != NULL)
@@ -637,7 +692,8 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 				// link first free process after pProc
 				pProc->pNext = pFreeProcesses;
 				pProc->pPrevious = NULL;
-				pFreeProcesses->pPrevious = pProc;
+				if (pFreeProcesses)
+					pFreeProcesses->pPrevious = pProc;
 
 				// make pProc the first free process
 				pFreeProcesses = pProc;
@@ -648,12 +704,6 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 		}
 	}
 
-#ifdef DEBUG
-	// adjust process in use
-	numProcs -= numKilled;
-	assert(numProcs >= 0);
-#endif
-
 	// return number of processes killed
 	return numKilled;
 }
@@ -662,23 +712,13 @@ void CoroutineScheduler::setResourceCallback(VFPTRPP pFunc) {
 	pRCfunction = pFunc;
 }
 
-PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
-	PROCESS *pProc = active->pNext;
-	while ((pProc != NULL) && (pProc->pid != pid))
-		pProc = pProc->pNext;
-
-	return pProc;
+bool CoroutineScheduler::processExists(uint32 pid) const {
+	return _pidCounts.contains(pid);
 }
 
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pid == pid)
-			return evt;
-	}
-
-	return NULL;
+	EventMap::iterator i = _events.find(pid);
+	return (i != _events.end()) ? i->_value : NULL;
 }
 
 
@@ -689,14 +729,14 @@ uint32 CoroutineScheduler::createEvent(bool bManualReset, bool bInitialState) {
 	evt->signalled = bInitialState;
 	evt->pulsing = false;
 
-	_events.push_back(evt);
+	_events[evt->pid] = evt;
 	return evt->pid;
 }
 
 void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
 	if (evt) {
-		_events.remove(evt);
+		_events.erase(pidEvent);
 		delete evt;
 	}
 }
@@ -721,6 +761,7 @@ void CoroutineScheduler::pulseEvent(uint32 pidEvent) {
 	// Set the event as signalled and pulsing
 	evt->signalled = true;
 	evt->pulsing = true;
+	_pulsedEvents.push_back(pidEvent);
 
 	// If there's an active process, and it's not the first in the queue, then reschedule all
 	// the other prcoesses in the queue to run again this frame
@@ -24,6 +24,8 @@
 
 #include "common/scummsys.h"
 #include "common/util.h"    // for SCUMMVM_CURRENT_FUNCTION
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/singleton.h"
 
@@ -284,7 +286,7 @@ public:
 // the size of process specific info
 #define CORO_PARAM_SIZE 32
 
-// the maximum number of processes
+// the number of processes the pool starts with, and grows by when it runs out
 #define CORO_NUM_PROCESS    100
 #define CORO_MAX_PROCESSES  100
 #define CORO_MAX_PID_WAITING 5
@@ -328,6 +330,19 @@ public:
 	/** Pointer to a function of the form "void function(PPROCESS)" */
 	typedef void (*VFPTRPP)(PROCESS *);
 
+	/** Scheduler statistics, for engine debuggers */
+	struct Stats {
+		uint numProcesses;      ///< number of active processes
+		uint maxProcesses;      ///< most processes active at once
+		uint poolSize;          ///< number of processes allocated in the pool
+		uint numSleeping;       ///< active processes sleeping for more than one tick
+		uint numWaiting;        ///< active processes waiting for processes or events
+		uint numDispatched;     ///< processes run during the last tick
+		uint32 numTicks;        ///< number of calls to schedule()
+		uint32 processTime;     ///< milliseconds spent in schedule(), running processes included
+		uint32 maxProcessTime;  ///< longest call to schedule(), in milliseconds
+	};
+
 private:
 	friend class Singleton<CoroutineScheduler>;
 
@@ -342,8 +357,8 @@ private:
 	~CoroutineScheduler();
 
 
-	/** list of all processes */
-	PROCESS *processList;
+	/** blocks of CORO_NUM_PROCESS processes each, making up the process pool */
+	Common::Array<PROCESS *> _processBlocks;
 
 	/** active process list - also saves scheduler state */
 	PROCESS *active;
@@ -357,14 +372,21 @@ private:
 	/** Auto-incrementing process Id */
 	int pidCounter;
 
-	/** Event list */
-	Common::List<EVENT *> _events;
+	/** Number of active processes with a given process Id */
+	typedef Common::HashMap<uint32, int> PidCountMap;
+	PidCountMap _pidCounts;
 
-#ifdef DEBUG
-	// diagnostic process counters
-	int numProcs;
-	int maxProcs;
+	/** Events, by their process Id */
+	typedef Common::HashMap<uint32, EVENT *> EventMap;
+	EventMap _events;
+
+	/** Events which were pulsed, and have to be reset after the next tick */
+	Common::Array<uint32> _pulsedEvents;
 
+	/** Scheduler statistics */
+	Stats _stats;
+
+#ifdef DEBUG
 	/**
 	 * Checks both the active and free process list to insure all the links are valid,
 	 * and that no processes have been lost
@@ -378,7 +400,29 @@ private:
 	 */
 	VFPTRPP pRCfunction;
 
-	PROCESS *getProcess(uint32 pid);
+	/**
+	 * Adds a block of CORO_NUM_PROCESS processes to the pool.
+	 */
+	void allocateProcessBlock();
+
+	/**
+	 * Places all the processes of a block on the free list.
+	 */
+	void linkProcessBlock(PROCESS *block);
+
+	/**
+	 * Checks whether the given pointer is a process from the pool.
+	 */
+	bool isValidProcess(const PROCESS *pProc) const;
+
+	/**
+	 * Updates the process Id counts when a process is added to or removed
+	 * from the active list.
+	 */
+	void addPid(uint32 pid);
+	void removePid(uint32 pid);
+
+	bool processExists(uint32 pid) const;
 	EVENT *getEvent(uint32 pid);
 public:
 	/**
@@ -398,6 +442,11 @@ public:
 	 */
 	void schedule();
 
+	/**
+	 * Returns the scheduler statistics.
+	 */
+	Stats getStats() const;
+
 	/**
 	 * Reschedules all the processes to run again this tick
 	 */
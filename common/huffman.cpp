@@ -29,10 +29,6 @@
 
 namespace Common {
 
-Huffman::Symbol::Symbol(uint32 c, uint32 s) : code(c), symbol(s) {
-}
-
-
 Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols) {
 	assert(codeCount > 0);
 
@@ -45,18 +41,19 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 
 	assert(maxLength <= 32);
 
-	_codes.resize(maxLength);
+	_maxLength = maxLength;
+	_tableBits = MIN<uint8>(maxLength, kMaxTableBits);
+
+	_codes.resize(codeCount);
+	_lengths.resize(codeCount);
 	_symbols.resize(codeCount);
 
 	for (uint32 i = 0; i < codeCount; i++) {
-		// The symbol. If none were specified, just assume it's identical to the code index
-		uint32 symbol = symbols ? symbols[i] : i;
-
-		// Put the code and symbol into the correct list
-		_codes[lengths[i] - 1].push_back(Symbol(codes[i], symbol));
+		_codes[i]   = codes[i];
+		_lengths[i] = lengths[i];
 
-		// And put the pointer to the symbol/code struct into the symbol list.
-		_symbols[i] = &_codes[lengths[i] - 1].back();
+		// The symbol. If none were specified, just assume it's identical to the code index
+		_symbols[i] = symbols ? symbols[i] : i;
 	}
 }
 
@@ -65,18 +62,98 @@ Huffman::~Huffman() {
 
 void Huffman::setSymbols(const uint32 *symbols) {
 	for (uint32 i = 0; i < _symbols.size(); i++)
-		_symbols[i]->symbol = symbols ? *symbols++ : i;
+		_symbols[i] = symbols ? *symbols++ : i;
+}
+
+/** Return the n bits of a code following its first skip bits, in the order they appear in the table index. */
+static inline uint32 getCodeBits(bool msb2lsb, uint32 code, uint8 length, uint8 skip, uint8 n) {
+	if (msb2lsb)
+		return (code >> (length - skip - n)) & ((1 << n) - 1);
+	else
+		return (code >> skip) & ((1 << n) - 1);
+}
+
+void Huffman::buildTable(bool msb2lsb, Table &table) const {
+	table.resize(1 << _tableBits);
+
+	// Shorter codes take precedence over longer ones with the same prefix and
+	// earlier codes over later ones of the same length, like they always did
+	// when comparing the codes one by one.
+	for (uint8 length = 1; length <= _maxLength; length++) {
+		for (uint32 i = 0; i < _codes.size(); i++) {
+			if (_lengths[i] != length)
+				continue;
+
+			const uint32 code = _codes[i];
+
+			// Codes with bits set beyond their length never matched
+			if (length < 32 && (code >> length) != 0)
+				continue;
+
+			uint32 offset = 0;
+			uint8 tableBits = _tableBits;
+			uint8 skip = 0;
+
+			while (length - skip > tableBits) {
+				// The code continues in a sub table
+				const uint32 index = offset + getCodeBits(msb2lsb, code, length, skip, tableBits);
+				if (table[index].length)
+					break;
+
+				if (!table[index].subBits) {
+					const uint8 subBits = MIN<uint8>(_maxLength - skip - tableBits, kMaxTableBits);
+
+					table[index].value   = table.size();
+					table[index].subBits = subBits;
+					table.resize(table.size() + (1 << subBits));
+				}
+
+				offset    = table[index].value;
+				skip     += tableBits;
+				tableBits = table[index].subBits;
+			}
+
+			if (length - skip > tableBits)
+				continue;
+
+			// Fill all entries starting with the remaining bits of the code
+			const uint8 left = length - skip;
+			const uint32 bits = getCodeBits(msb2lsb, code, length, skip, left);
+
+			for (uint32 j = 0; j < (1U << (tableBits - left)); j++) {
+				TableEntry &entry = table[offset + (msb2lsb ? ((bits << (tableBits - left)) | j) : (bits | (j << left)))];
+
+				if (!entry.length && !entry.subBits) {
+					entry.value  = i;
+					entry.length = left;
+				}
+			}
+		}
+	}
 }
 
 uint32 Huffman::getSymbol(BitStream &bits) const {
-	uint32 code = 0;
+	Table &table = _tables[bits.isMSB2LSB() ? 1 : 0];
+	if (table.empty())
+		buildTable(bits.isMSB2LSB(), table);
+
+	uint32 offset = 0;
+	uint8 tableBits = _tableBits;
+
+	for (;;) {
+		const TableEntry &entry = table[offset + bits.peekBits(tableBits)];
+
+		if (entry.length) {
+			bits.skip(entry.length);
+			return _symbols[entry.value];
+		}
 
-	for (uint32 i = 0; i < _codes.size(); i++) {
-		bits.addBit(code, i);
+		if (!entry.subBits)
+			break;
 
-		for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-			if (code == cCode->code)
-				return cCode->symbol;
+		bits.skip(tableBits);
+		offset    = entry.value;
+		tableBits = entry.subBits;
 	}
 
 	error("Unknown Huffman code");
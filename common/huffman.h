@@ -26,7 +26,6 @@
 #define COMMON_HUFFMAN_H
 
 #include "common/array.h"
-#include "common/list.h"
 #include "common/types.h"
 
 namespace Common {
@@ -36,6 +35,10 @@ class BitStream;
 /**
  * Huffman bitstream decoding
  *
+ * Symbols are decoded with multi-level lookup tables: most codes are
+ * resolved by peeking a fixed number of bits and a single table lookup,
+ * longer ones by following further sub tables.
+ *
  * Used in engines:
  *  - scumm
  */
@@ -59,22 +62,37 @@ public:
 	uint32 getSymbol(BitStream &bits) const;
 
 private:
-	struct Symbol {
-		uint32 code;
-		uint32 symbol;
+	enum {
+		/** Maximal number of bits looked up at once. */
+		kMaxTableBits = 9
+	};
+
+	/** An entry of a lookup table. */
+	struct TableEntry {
+		uint32 value;   ///< Index of the code, or the offset of the sub table.
+		uint8  length;  ///< Number of the code's bits left, 0 if this is no code.
+		uint8  subBits; ///< Number of bits looked up in the sub table, 0 if there is none.
 
-		Symbol(uint32 c, uint32 s);
+		TableEntry() : value(0), length(0), subBits(0) {}
 	};
 
-	typedef List<Symbol> CodeList;
-	typedef Array<CodeList> CodeLists;
-	typedef Array<Symbol *> SymbolList;
+	typedef Array<TableEntry> Table;
 
-	/** Lists of codes and their symbols, sorted by code length. */
-	CodeLists _codes;
+	/** Build the lookup tables for the given bit order. */
+	void buildTable(bool msb2lsb, Table &table) const;
 
-	/** Sorted list of pointers to the symbols. */
-	SymbolList _symbols;
+	uint8 _maxLength;
+	uint8 _tableBits; ///< Number of bits looked up in the first table.
+
+	Array<uint32> _codes;
+	Array<uint8>  _lengths;
+	Array<uint32> _symbols;
+
+	/**
+	 * Lookup tables for LSB2MSB and MSB2LSB bit streams. They are built
+	 * once used, as a code table is normally read in one order only.
+	 */
+	mutable Table _tables[2];
 };
 
 } // End of namespace Common
@@ -25,6 +25,7 @@
 
 #include "common/stream.h"
 #include "common/types.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -35,9 +36,7 @@ namespace Common {
 class MemoryReadStream : public SeekableReadStream {
 private:
 	const byte * const _ptrOrig;
-	const byte *_ptr;
 	const uint32 _size;
-	uint32 _pos;
 	DisposeAfterUse::Flag _disposeMemory;
 	bool _eos;
 
@@ -50,11 +49,13 @@ public:
 	 */
 	MemoryReadStream(const byte *dataPtr, uint32 dataSize, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO) :
 		_ptrOrig(dataPtr),
-		_ptr(dataPtr),
 		_size(dataSize),
-		_pos(0),
 		_disposeMemory(disposeMemory),
-		_eos(false) {}
+		_eos(false) {
+		// The whole buffer is the read window, its start is our position
+		_windowPos = dataPtr;
+		_windowEnd = dataPtr + dataSize;
+	}
 
 	~MemoryReadStream() {
 		if (_disposeMemory)
@@ -66,7 +67,7 @@ public:
 	bool eos() const { return _eos; }
 	void clearErr() { _eos = false; }
 
-	int32 pos() const { return _pos; }
+	int32 pos() const { return _windowPos - _ptrOrig; }
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
@@ -170,7 +171,9 @@ private:
 
 		byte *old_data = _data;
 
-		_capacity = new_len + 32;
+		// Grow geometrically, so that many small writes do not end up
+		// copying the whole buffer over and over
+		_capacity = MAX(new_len + 32, _capacity * 2);
 		_data = (byte *)malloc(_capacity);
 		_ptr = _data + _pos;
 
@@ -46,6 +46,16 @@ typedef SeekableReadStream InSaveFile;
  */
 typedef WriteStream OutSaveFile;
 
+/**
+ * Callback notified once a savefile opened with
+ * SaveFileManager::openForSavingAsync() has been written out.
+ *
+ * @param name		the name of the savefile
+ * @param success	whether the savefile was written successfully
+ * @param refCon	the pointer passed to openForSavingAsync()
+ */
+typedef void (*SaveCompletionProc)(const String &name, bool success, void *refCon);
+
 
 /**
  * The SaveFileManager is serving as a factory for InSaveFile
@@ -122,6 +132,37 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the savefile with the specified name for saving in the
+	 * background. Data written to the returned stream may be kept in
+	 * memory only; compression and the actual file write can then happen
+	 * on another thread after the stream has been finalized (or deleted),
+	 * so the caller is not held up by them.
+	 *
+	 * The savefile replaces any existing file of the same name atomically
+	 * where supported, so a failed write leaves the previous one intact.
+	 * Since errors may only be known once the data has been written, they
+	 * are reported to the completion callback rather than through err().
+	 *
+	 * The default implementation simply writes synchronously through
+	 * openForSaving() and calls the callback when the stream is finalized.
+	 *
+	 * @param name		the name of the savefile
+	 * @param proc		optional callback notified when the savefile has
+	 *					been written. It may be invoked from another thread.
+	 * @param refCon	an arbitrary pointer passed to the callback
+	 * @param compress	toggles whether to compress the resulting save file
+	 * @return pointer to an OutSaveFile, or NULL if an error occurred (the
+	 *         callback is not invoked then).
+	 */
+	virtual OutSaveFile *openForSavingAsync(const String &name, SaveCompletionProc proc = 0, void *refCon = 0, bool compress = true);
+
+	/**
+	 * Wait until all savefiles opened with openForSavingAsync() have been
+	 * written and their completion callbacks invoked.
+	 */
+	virtual void waitForPendingSaves() {}
+
 	/**
 	 * Open the file with the specified name in the given directory for loading.
 	 * @param name	the name of the savefile
@@ -161,6 +202,47 @@ public:
 	 * @see Common::matchString()
 	 */
 	virtual StringArray listSavefiles(const String &pattern) = 0;
+
+	/**
+	 * Look up the metadata cached for a save slot of the given target.
+	 *
+	 * Savefile managers may keep a per-target metadata index, so that save
+	 * and load dialogs do not need to open and parse every savefile. Entries
+	 * are dropped automatically when the savefile they were taken from is
+	 * written, removed or changed in size, the data itself is opaque to the
+	 * savefile manager.
+	 *
+	 * The default implementation does not cache anything.
+	 *
+	 * @param target	the target the savefile belongs to
+	 * @param slot		the save slot
+	 * @return a stream with the data passed to storeCachedMetaInfo(), or
+	 *         NULL if nothing is cached for the slot. The caller has to
+	 *         delete it.
+	 */
+	virtual SeekableReadStream *openCachedMetaInfo(const String &target, int slot) { return 0; }
+
+	/**
+	 * Store metadata of a save slot in the given target's metadata index.
+	 * The index is not necessarily written out before flushCachedMetaInfos()
+	 * is called.
+	 *
+	 * Only savefiles named "<target>.<suffix>" can be cached, since the
+	 * target is derived from the name when the savefile is written or
+	 * removed. Others are silently ignored.
+	 *
+	 * @param target	the target the savefile belongs to
+	 * @param slot		the save slot
+	 * @param savefile	the name of the savefile holding the slot
+	 * @param data		the data to cache
+	 * @param size		the size of the data
+	 */
+	virtual void storeCachedMetaInfo(const String &target, int slot, const String &savefile, const byte *data, uint32 size) {}
+
+	/**
+	 * Write out any changes made to the metadata index.
+	 */
+	virtual void flushCachedMetaInfos() {}
 };
 
 } // End of namespace Common
@@ -42,21 +42,21 @@ SeekableReadStream *ReadStream::readStream(uint32 dataSize) {
 
 uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Read at most as many bytes as are still available...
-	if (dataSize > _size - _pos) {
-		dataSize = _size - _pos;
+	const uint32 bytesLeft = _windowEnd - _windowPos;
+	if (dataSize > bytesLeft) {
+		dataSize = bytesLeft;
 		_eos = true;
 	}
-	memcpy(dataPtr, _ptr, dataSize);
+	memcpy(dataPtr, _windowPos, dataSize);
 
-	_ptr += dataSize;
-	_pos += dataSize;
+	_windowPos += dataSize;
 
 	return dataSize;
 }
 
 bool MemoryReadStream::seek(int32 offs, int whence) {
 	// Pre-Condition
-	assert(_pos <= _size);
+	assert(_windowPos <= _windowEnd);
 	switch (whence) {
 	case SEEK_END:
 		// SEEK_END works just like SEEK_SET, only 'reversed',
@@ -64,17 +64,15 @@ bool MemoryReadStream::seek(int32 offs, int whence) {
 		offs = _size + offs;
 		// Fall through
 	case SEEK_SET:
-		_ptr = _ptrOrig + offs;
-		_pos = offs;
+		_windowPos = _ptrOrig + offs;
 		break;
 
 	case SEEK_CUR:
-		_ptr += offs;
-		_pos += offs;
+		_windowPos += offs;
 		break;
 	}
 	// Post-Condition
-	assert(_pos <= _size);
+	assert(_windowPos >= _ptrOrig && _windowPos <= _windowEnd);
 
 	// Reset end-of-stream flag on a successful seek
 	_eos = false;
@@ -261,11 +259,19 @@ class BufferedReadStream : virtual public ReadStream {
 protected:
 	DisposablePtr<ReadStream> _parentStream;
 	byte *_buf;
-	uint32 _pos;
 	bool _eos; // end of stream
 	uint32 _bufSize;
 	uint32 _realBufSize;
 
+	// The buffered data is exposed as the read window, the current
+	// position inside the buffer is the window position.
+	uint32 bufPos() const { return _windowPos - _buf; }
+	void setBuffer(uint32 pos, uint32 size) {
+		_bufSize = size;
+		_windowPos = _buf + pos;
+		_windowEnd = _buf + size;
+	}
+
 public:
 	BufferedReadStream(ReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 	virtual ~BufferedReadStream();
@@ -279,7 +285,6 @@ public:
 
 BufferedReadStream::BufferedReadStream(ReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream)
 	: _parentStream(parentStream, disposeParentStream),
-	_pos(0),
 	_eos(false),
 	_bufSize(0),
 	_realBufSize(bufSize) {
@@ -287,6 +292,7 @@ BufferedReadStream::BufferedReadStream(ReadStream *parentStream, uint32 bufSize,
 	assert(parentStream);
 	_buf = new byte[bufSize];
 	assert(_buf);
+	setBuffer(0, 0);
 }
 
 BufferedReadStream::~BufferedReadStream() {
@@ -295,7 +301,7 @@ BufferedReadStream::~BufferedReadStream() {
 
 uint32 BufferedReadStream::read(void *dataPtr, uint32 dataSize) {
 	uint32 alreadyRead = 0;
-	const uint32 bufBytesLeft = _bufSize - _pos;
+	const uint32 bufBytesLeft = _bufSize - bufPos();
 
 	// Check whether the data left in the buffer suffices....
 	if (dataSize > bufBytesLeft) {
@@ -303,8 +309,8 @@ uint32 BufferedReadStream::read(void *dataPtr, uint32 dataSize) {
 
 		// First, flush the buffer, if it is non-empty
 		if (0 < bufBytesLeft) {
-			memcpy(dataPtr, _buf + _pos, bufBytesLeft);
-			_pos = _bufSize;
+			memcpy(dataPtr, _windowPos, bufBytesLeft);
+			_windowPos = _windowEnd;
 			alreadyRead += bufBytesLeft;
 			dataPtr = (byte *)dataPtr + bufBytesLeft;
 			dataSize -= bufBytesLeft;
@@ -324,8 +330,7 @@ uint32 BufferedReadStream::read(void *dataPtr, uint32 dataSize) {
 		// is EOF or an error. In that case we truncate the buffer
 		// size, as well as the number of  bytes we are going to
 		// return to the caller.
-		_bufSize = _parentStream->read(_buf, _realBufSize);
-		_pos = 0;
+		setBuffer(0, _parentStream->read(_buf, _realBufSize));
 		if (_bufSize < dataSize) {
 			// we didn't get enough data from parent
 			if (_parentStream->eos())
@@ -336,8 +341,8 @@ uint32 BufferedReadStream::read(void *dataPtr, uint32 dataSize) {
 
 	if (dataSize) {
 		// Satisfy the request from the buffer
-		memcpy(dataPtr, _buf + _pos, dataSize);
-		_pos += dataSize;
+		memcpy(dataPtr, _windowPos, dataSize);
+		_windowPos += dataSize;
 	}
 	return alreadyRead + dataSize;
 }
@@ -365,7 +370,7 @@ protected:
 public:
 	BufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream = DisposeAfterUse::NO);
 
-	virtual int32 pos() const { return _parentStream->pos() - (_bufSize - _pos); }
+	virtual int32 pos() const { return _parentStream->pos() - (_bufSize - bufPos()); }
 	virtual int32 size() const { return _parentStream->size(); }
 
 	virtual bool seek(int32 offset, int whence = SEEK_SET);
@@ -396,8 +401,8 @@ bool BufferedSeekableReadStream::seek(int32 offset, int whence) {
 		break;
 	}
 
-	if ((int)_pos + relOffset >= 0 && _pos + relOffset <= _bufSize) {
-		_pos += relOffset;
+	if ((int)bufPos() + relOffset >= 0 && bufPos() + relOffset <= _bufSize) {
+		_windowPos += relOffset;
 
 		// Note: we do not need to reset parent's eos flag here. It is
 		// sufficient that it is reset when actually seeking in the parent.
@@ -405,7 +410,7 @@ bool BufferedSeekableReadStream::seek(int32 offset, int whence) {
 		// Seek was not local enough, so we reset the buffer and
 		// just seek normally in the parent stream.
 		if (whence == SEEK_CUR)
-			offset -= (_bufSize - _pos);
+			offset -= (_bufSize - bufPos());
 		// We invalidate the buffer here. This assures that successive seeks
 		// do not have the chance to incorrectly think they seeked back into
 		// the buffer.
@@ -413,7 +418,7 @@ bool BufferedSeekableReadStream::seek(int32 offset, int whence) {
 		// a simple way to prevent nasty errors. It would be possible to take
 		// full advantage of the buffer by saving its actual start position.
 		// This seems not worth the effort for this seemingly uncommon use.
-		_pos = _bufSize = 0;
+		setBuffer(0, 0);
 		_parentStream->seek(offset, whence);
 	}
 
@@ -163,6 +163,8 @@ public:
  */
 class ReadStream : virtual public Stream {
 public:
+	ReadStream() : _windowPos(0), _windowEnd(0) {}
+
 	/**
 	 * Returns true if a read failed because the stream end has been reached.
 	 * This flag is cleared by clearErr().
@@ -200,6 +202,9 @@ public:
 	 * calling err() and eos() ).
 	 */
 	byte readByte() {
+		if (_windowPos < _windowEnd)
+			return *_windowPos++;
+
 		byte b = 0; // FIXME: remove initialisation
 		read(&b, 1);
 		return b;
@@ -223,6 +228,12 @@ public:
 	 * calling err() and eos() ).
 	 */
 	uint16 readUint16LE() {
+		if (_windowEnd - _windowPos >= 2) {
+			uint16 val = READ_LE_UINT16(_windowPos);
+			_windowPos += 2;
+			return val;
+		}
+
 		uint16 val;
 		read(&val, 2);
 		return FROM_LE_16(val);
@@ -236,6 +247,12 @@ public:
 	 * calling err() and eos() ).
 	 */
 	uint32 readUint32LE() {
+		if (_windowEnd - _windowPos >= 4) {
+			uint32 val = READ_LE_UINT32(_windowPos);
+			_windowPos += 4;
+			return val;
+		}
+
 		uint32 val;
 		read(&val, 4);
 		return FROM_LE_32(val);
@@ -249,6 +266,12 @@ public:
 	 * calling err() and eos() ).
 	 */
 	uint16 readUint16BE() {
+		if (_windowEnd - _windowPos >= 2) {
+			uint16 val = READ_BE_UINT16(_windowPos);
+			_windowPos += 2;
+			return val;
+		}
+
 		uint16 val;
 		read(&val, 2);
 		return FROM_BE_16(val);
@@ -262,6 +285,12 @@ public:
 	 * calling err() and eos() ).
 	 */
 	uint32 readUint32BE() {
+		if (_windowEnd - _windowPos >= 4) {
+			uint32 val = READ_BE_UINT32(_windowPos);
+			_windowPos += 4;
+			return val;
+		}
+
 		uint32 val;
 		read(&val, 4);
 		return FROM_BE_32(val);
@@ -321,6 +350,39 @@ public:
 	 */
 	SeekableReadStream *readStream(uint32 dataSize);
 
+	/**
+	 * Returns a pointer to the data which can be read directly from memory
+	 * at the current position, and sets size to the number of bytes
+	 * available there. Streams which do not keep their data in memory
+	 * return an empty window (size 0); use read() for those.
+	 *
+	 * The window stays valid until the next call to any other method of
+	 * the stream. Use consumeReadWindow() to skip the bytes processed.
+	 */
+	const byte *getReadWindow(uint32 &size) const {
+		size = _windowEnd - _windowPos;
+		return _windowPos;
+	}
+
+	/**
+	 * Advance the stream position past bytes of the read window.
+	 */
+	void consumeReadWindow(uint32 bytes) {
+		assert(bytes <= (uint32)(_windowEnd - _windowPos));
+		_windowPos += bytes;
+	}
+
+protected:
+	/**
+	 * Contiguous in-memory data directly available at the current stream
+	 * position. The byte, word and dword readers above consume it without
+	 * going through the virtual read(), which they only use when the
+	 * window is exhausted. Implementations keeping their data in memory
+	 * point the window at it, and must take any bytes consumed this way
+	 * into account for their position.
+	 */
+	const byte *_windowPos;
+	const byte *_windowEnd;
 };
 
 
@@ -0,0 +1,83 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a utility for timing some of the performance critical code in
+ * common/ and graphics/ outside of the unit tests
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+
+struct Benchmark {
+	const char *name;
+	void (*run)(int argc, char *argv[]);
+};
+
+static const Benchmark benchmarks[] = {
+	{ "streamwindow", benchmarkStreamWindow },
+	{ "huffman", benchmarkHuffman },
+	{ "jpeg", benchmarkJPEG },
+	{ "yuvtorgb", benchmarkYUVToRGB },
+	{ "conversion", benchmarkConversion },
+	{ 0, 0 }
+};
+
+long toMilliseconds(clock_t time) {
+	return (long)(time * 1000 / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1 && !strcmp(argv[1], "--list")) {
+		for (const Benchmark *b = benchmarks; b->name; b++)
+			printf("%s\n", b->name);
+		return 0;
+	}
+
+	// Run the benchmark given on the command line with the remaining
+	// arguments, or all of them without any
+	for (const Benchmark *b = benchmarks; b->name; b++) {
+		if (argc == 1) {
+			printf("%s:\n", b->name);
+			b->run(0, 0);
+		} else if (!strcmp(argv[1], b->name)) {
+			printf("%s:\n", b->name);
+			b->run(argc - 2, argv + 2);
+			return 0;
+		}
+	}
+
+	if (argc > 1) {
+		fprintf(stderr, "Unknown benchmark '%s'\n", argv[1]);
+		return 1;
+	}
+
+	return 0;
+}
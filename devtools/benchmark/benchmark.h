@@ -0,0 +1,44 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a utility for timing some of the performance critical code in
+ * common/ and graphics/ outside of the unit tests
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <time.h>
+
+#include "common/scummsys.h"
+
+/**
+ * Convert a clock() difference to milliseconds.
+ */
+long toMilliseconds(clock_t time);
+
+// Each benchmark gets the arguments following its name on the command line
+void benchmarkStreamWindow(int argc, char *argv[]);
+void benchmarkHuffman(int argc, char *argv[]);
+void benchmarkJPEG(int argc, char *argv[]);
+void benchmarkYUVToRGB(int argc, char *argv[]);
+void benchmarkConversion(int argc, char *argv[]);
+
+#endif // BENCHMARK_H
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+
+#include "benchmark.h"
+
+#include "common/util.h"
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+enum {
+	kConversionWidth = 640,
+	kConversionHeight = 480,
+	kConversionIterations = 50
+};
+
+struct ConversionFormat {
+	const char *name;
+	Graphics::PixelFormat format;
+};
+
+static void fillSurface(Graphics::Surface &surface) {
+	uint32 seed = 12345;
+	for (int y = 0; y < surface.h; y++) {
+		byte *row = (byte *)surface.getBasePtr(0, y);
+		for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++) {
+			seed = seed * 1103515245 + 12345;
+			row[x] = seed >> 16;
+		}
+	}
+}
+
+/**
+ * Times crossBlit() between common formats and the conversion of paletted
+ * surfaces with Surface::convertTo().
+ */
+void benchmarkConversion(int argc, char *argv[]) {
+	const ConversionFormat formats[] = {
+		{ "RGB565",   Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		{ "RGB555",   Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) },
+		{ "ARGB1555", Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15) },
+		{ "RGB888",   Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0) },
+		{ "XRGB8888", Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0) },
+		{ "ARGB8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24) },
+		{ "RGBA8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) }
+	};
+
+	printf("  %dx%d, %d frames each\n", kConversionWidth, kConversionHeight, kConversionIterations);
+
+	for (int i = 0; i < ARRAYSIZE(formats); i++) {
+		Graphics::Surface src;
+		src.create(kConversionWidth, kConversionHeight, formats[i].format);
+		fillSurface(src);
+
+		printf("  %-8s to", formats[i].name);
+
+		// crossBlit() cannot write 3 bytes per pixel
+		for (int j = 0; j < ARRAYSIZE(formats); j++) {
+			if (i == j || formats[j].format.bytesPerPixel == 3)
+				continue;
+
+			Graphics::Surface dst;
+			dst.create(kConversionWidth, kConversionHeight, formats[j].format);
+
+			clock_t start = clock();
+			for (int k = 0; k < kConversionIterations; k++)
+				Graphics::crossBlit((byte *)dst.pixels, (const byte *)src.pixels, dst.pitch, src.pitch, kConversionWidth, kConversionHeight, dst.format, src.format);
+			clock_t time = clock() - start;
+
+			printf(" %s %ld ms", formats[j].name, toMilliseconds(time));
+
+			dst.free();
+		}
+
+		printf("\n");
+		src.free();
+	}
+
+	byte palette[256 * 3];
+	for (int i = 0; i < 256 * 3; i++)
+		palette[i] = i * 7 + (i >> 3);
+
+	Graphics::Surface src;
+	src.create(kConversionWidth, kConversionHeight, Graphics::PixelFormat::createFormatCLUT8());
+	fillSurface(src);
+
+	printf("  CLUT8    to");
+
+	const int targets[] = { 0, 4 };
+	for (int i = 0; i < ARRAYSIZE(targets); i++) {
+		clock_t start = clock();
+		for (int k = 0; k < kConversionIterations; k++) {
+			Graphics::Surface *converted = src.convertTo(formats[targets[i]].format, palette);
+			converted->free();
+			delete converted;
+		}
+		clock_t time = clock() - start;
+
+		printf(" %s %ld ms", formats[targets[i]].name, toMilliseconds(time));
+	}
+
+	printf("\n");
+	src.free();
+}
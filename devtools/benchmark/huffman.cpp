@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+
+#include "common/array.h"
+#include "common/bitstream.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+
+enum {
+	kHuffmanSymbols = 300,
+	kHuffmanMaxLength = 18,
+	kHuffmanStreamSymbols = 1000000
+};
+
+static uint8 s_lengths[kHuffmanSymbols];
+static uint32 s_codes[kHuffmanSymbols];
+
+/**
+ * Generate a complete canonical code with long codes, by splitting random
+ * leaves of a code tree, and a random stream of its symbols.
+ */
+static void generateCode(uint32 *stream) {
+	uint32 seed = 1;
+	uint32 count = 1;
+	s_lengths[0] = 0;
+
+	while (count < kHuffmanSymbols) {
+		seed = seed * 1103515245 + 12345;
+		uint32 leaf = (seed >> 16) % count;
+		if (s_lengths[leaf] >= kHuffmanMaxLength)
+			continue;
+
+		s_lengths[leaf]++;
+		s_lengths[count++] = s_lengths[leaf];
+	}
+
+	uint32 code = 0;
+	for (uint8 length = 1; length <= kHuffmanMaxLength; length++) {
+		for (uint32 i = 0; i < kHuffmanSymbols; i++)
+			if (s_lengths[i] == length)
+				s_codes[i] = code++;
+		code <<= 1;
+	}
+
+	for (uint32 i = 0; i < kHuffmanStreamSymbols; i++) {
+		seed = seed * 1103515245 + 12345;
+		stream[i] = (seed >> 16) % kHuffmanSymbols;
+	}
+}
+
+static byte *encode(const uint32 *stream, uint32 &size) {
+	size = kHuffmanStreamSymbols * kHuffmanMaxLength / 8 + 4;
+	byte *data = new byte[size];
+	memset(data, 0, size);
+
+	uint32 pos = 0;
+	for (uint32 i = 0; i < kHuffmanStreamSymbols; i++) {
+		uint8 length = s_lengths[stream[i]];
+		uint32 code = s_codes[stream[i]];
+
+		for (uint8 j = 0; j < length; j++, pos++)
+			data[pos / 8] |= ((code >> (length - 1 - j)) & 1) << (7 - pos % 8);
+	}
+
+	return data;
+}
+
+/** Decode a symbol by comparing the codes one by one, the way Huffman used to. */
+static uint32 getSymbolReference(Common::BitStream &bits, const Common::Array<Common::Array<uint32> > &codesByLength) {
+	uint32 code = 0;
+
+	for (uint32 i = 0; i < codesByLength.size(); i++) {
+		bits.addBit(code, i);
+
+		for (uint32 j = 0; j < codesByLength[i].size(); j++)
+			if (code == s_codes[codesByLength[i][j]])
+				return codesByLength[i][j];
+	}
+
+	return 0xFFFFFFFF;
+}
+
+void benchmarkHuffman(int argc, char *argv[]) {
+	uint32 *stream = new uint32[kHuffmanStreamSymbols];
+	generateCode(stream);
+
+	Common::Array<Common::Array<uint32> > codesByLength;
+	codesByLength.resize(kHuffmanMaxLength);
+	for (uint32 i = 0; i < kHuffmanSymbols; i++)
+		codesByLength[s_lengths[i] - 1].push_back(i);
+
+	Common::Huffman huffman(0, kHuffmanSymbols, s_codes, s_lengths, 0);
+
+	uint32 size;
+	byte *data = encode(stream, size);
+	Common::MemoryReadStream dataStream(data, size);
+	Common::BitStream8MSB bits(dataStream);
+
+	uint32 errors = 0;
+	clock_t start = clock();
+	for (uint32 i = 0; i < kHuffmanStreamSymbols; i++)
+		if (huffman.getSymbol(bits) != stream[i])
+			errors++;
+	clock_t tableTime = clock() - start;
+
+	bits.rewind();
+
+	start = clock();
+	for (uint32 i = 0; i < kHuffmanStreamSymbols; i++)
+		if (getSymbolReference(bits, codesByLength) != stream[i])
+			errors++;
+	clock_t referenceTime = clock() - start;
+
+	if (errors)
+		printf("  WARNING: %d symbols were decoded wrongly\n", errors);
+
+	printf("  %d symbols: lookup tables %ld ms, comparing codes %ld ms\n",
+		kHuffmanStreamSymbols, toMilliseconds(tableTime), toMilliseconds(referenceTime));
+
+	delete[] data;
+	delete[] stream;
+}
@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+
+#include "benchmark.h"
+
+#include "jpeg_old.h"
+
+#include "common/memstream.h"
+#include "common/util.h"
+#include "graphics/pixelformat.h"
+#include "graphics/decoders/jpeg.h"
+
+enum {
+	kJPEGIterations = 100
+};
+
+static byte *readFile(const char *filename, uint32 &size) {
+	FILE *file = fopen(filename, "rb");
+	if (!file)
+		return 0;
+
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	byte *data = new byte[size];
+	if (fread(data, 1, size, file) != size) {
+		delete[] data;
+		data = 0;
+	}
+
+	fclose(file);
+	return data;
+}
+
+/**
+ * Times decoding a file with the current decoder, converting it to the
+ * given format through setOutputPixelFormat().
+ */
+static clock_t timeDecoder(const byte *data, uint32 size, const Graphics::PixelFormat &format) {
+	clock_t start = clock();
+	for (int i = 0; i < kJPEGIterations; i++) {
+		Common::MemoryReadStream stream(data, size);
+		Graphics::JPEGDecoder jpeg;
+		jpeg.setOutputPixelFormat(format);
+		jpeg.loadStream(stream);
+		jpeg.getSurface();
+	}
+
+	return clock() - start;
+}
+
+/**
+ * Times decoding a file with the previous decoder, converting its RGBA
+ * surface to the given format afterwards as the callers used to.
+ */
+static clock_t timeOldDecoder(const byte *data, uint32 size, const Graphics::PixelFormat &format) {
+	clock_t start = clock();
+	for (int i = 0; i < kJPEGIterations; i++) {
+		Common::MemoryReadStream stream(data, size);
+		Graphics::OldJPEGDecoder jpeg;
+		jpeg.loadStream(stream);
+
+		const Graphics::Surface *surface = jpeg.getSurface();
+		if (surface->format != format) {
+			Graphics::Surface *converted = surface->convertTo(format);
+			converted->free();
+			delete converted;
+		}
+	}
+
+	return clock() - start;
+}
+
+/**
+ * Decodes each of the given files to RGBA8888 and RGB565 a number of times,
+ * with both the previous and the current decoder.
+ */
+void benchmarkJPEG(int argc, char *argv[]) {
+	if (argc == 0) {
+		printf("  No JPEG files given, skipped\n");
+		return;
+	}
+
+	const Graphics::PixelFormat formats[] = {
+		Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0),
+		Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0)
+	};
+
+	for (int i = 0; i < argc; i++) {
+		uint32 size;
+		byte *data = readFile(argv[i], size);
+		if (!data) {
+			printf("  %s: could not be read\n", argv[i]);
+			continue;
+		}
+
+		Common::MemoryReadStream stream(data, size);
+		Graphics::JPEGDecoder jpeg;
+		if (!jpeg.loadStream(stream)) {
+			printf("  %s: could not be decoded\n", argv[i]);
+			delete[] data;
+			continue;
+		}
+
+		for (int j = 0; j < ARRAYSIZE(formats); j++) {
+			clock_t oldTime = timeOldDecoder(data, size, formats[j]);
+			clock_t newTime = timeDecoder(data, size, formats[j]);
+
+			printf("  %s %dx%d: %d decodes to %d bpp, old %ld ms, new %ld ms\n",
+				argv[i], jpeg.getWidth(), jpeg.getHeight(), kJPEGIterations,
+				formats[j].bytesPerPixel * 8, toMilliseconds(oldTime), toMilliseconds(newTime));
+		}
+
+		delete[] data;
+	}
+}
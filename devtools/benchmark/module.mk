@@ -0,0 +1,19 @@
+MODULE := devtools/benchmark
+
+MODULE_OBJS := \
+	benchmark.o \
+	conversion.o \
+	huffman.o \
+	jpeg.o \
+	jpeg_old.o \
+	stream.o \
+	yuv_to_rgb.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := benchmark
+
+# Link against the code being timed
+TOOL_DEPS := graphics/libgraphics.a common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
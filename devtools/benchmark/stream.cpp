@@ -0,0 +1,83 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+
+#include "benchmark.h"
+
+#include "common/memstream.h"
+#include "common/substream.h"
+
+enum {
+	kStreamDataSize = 256 * 1024,
+	kStreamPasses = 8
+};
+
+static uint32 readAll(Common::SeekableReadStream &stream) {
+	uint32 sum = 0;
+	for (int pass = 0; pass < kStreamPasses; ++pass) {
+		stream.seek(0, SEEK_SET);
+		for (int i = 0; i < kStreamDataSize / 13; ++i) {
+			sum += stream.readByte();
+			sum ^= stream.readUint16LE();
+			sum += stream.readUint32BE();
+			sum ^= stream.readUint16BE();
+			sum += stream.readUint32LE();
+			sum = (sum << 1) | (sum >> 31);
+		}
+	}
+	return sum;
+}
+
+/**
+ * Compares the read window fast path of the endian readers with the virtual
+ * read() path. SeekableSubReadStream does not provide a window, so reading
+ * the same data through it always takes the read() path.
+ */
+void benchmarkStreamWindow(int argc, char *argv[]) {
+	byte *data = new byte[kStreamDataSize];
+	for (int i = 0; i < kStreamDataSize; ++i)
+		data[i] = (byte)(i * 37 + (i >> 8));
+
+	Common::MemoryReadStream windowed(data, kStreamDataSize);
+	Common::MemoryReadStream parent(data, kStreamDataSize);
+	Common::SeekableSubReadStream unwindowed(&parent, 0, kStreamDataSize);
+
+	clock_t start = clock();
+	uint32 windowedSum = readAll(windowed);
+	clock_t windowedTime = clock() - start;
+
+	start = clock();
+	uint32 unwindowedSum = readAll(unwindowed);
+	clock_t unwindowedTime = clock() - start;
+
+	if (windowedSum != unwindowedSum)
+		printf("  WARNING: the two paths read different data\n");
+
+	printf("  %d KiB of small reads: read window %ld ms, virtual read() %ld ms\n",
+		kStreamDataSize * kStreamPasses / 1024, toMilliseconds(windowedTime), toMilliseconds(unwindowedTime));
+
+	delete[] data;
+}
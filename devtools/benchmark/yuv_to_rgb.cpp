@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+
+#include "benchmark.h"
+
+#include "common/util.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+enum {
+	kYUVWidth = 1280,
+	kYUVHeight = 720,
+	kYUVIterations = 40
+};
+
+/**
+ * Converts a 1280x720 frame from each of the YUV layouts to 16 and 32 bpp.
+ */
+void benchmarkYUVToRGB(int argc, char *argv[]) {
+	// The chroma planes are large enough for all three layouts, including
+	// the extra row and column read by the YUV410 interpolation
+	byte *y = new byte[kYUVWidth * kYUVHeight];
+	byte *u = new byte[(kYUVWidth + 1) * (kYUVHeight + 1)];
+	byte *v = new byte[(kYUVWidth + 1) * (kYUVHeight + 1)];
+
+	uint32 seed = 1;
+	for (int i = 0; i < kYUVWidth * kYUVHeight; i++) {
+		seed = seed * 1103515245 + 12345;
+		y[i] = seed >> 16;
+	}
+
+	for (int i = 0; i < (kYUVWidth + 1) * (kYUVHeight + 1); i++) {
+		seed = seed * 1103515245 + 12345;
+		u[i] = seed >> 16;
+		v[i] = seed >> 24;
+	}
+
+	const Graphics::PixelFormat formats[] = {
+		Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+		Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+	};
+
+	for (int i = 0; i < ARRAYSIZE(formats); i++) {
+		Graphics::Surface surface;
+		surface.create(kYUVWidth, kYUVHeight, formats[i]);
+
+		clock_t start = clock();
+		for (int j = 0; j < kYUVIterations; j++)
+			YUVToRGBMan.convert444(&surface, Graphics::YUVToRGBManager::kScaleITU, y, u, v, kYUVWidth, kYUVHeight, kYUVWidth, kYUVWidth);
+		clock_t time444 = clock() - start;
+
+		start = clock();
+		for (int j = 0; j < kYUVIterations; j++)
+			YUVToRGBMan.convert420(&surface, Graphics::YUVToRGBManager::kScaleITU, y, u, v, kYUVWidth, kYUVHeight, kYUVWidth, kYUVWidth + 1);
+		clock_t time420 = clock() - start;
+
+		start = clock();
+		for (int j = 0; j < kYUVIterations; j++)
+			YUVToRGBMan.convert410(&surface, Graphics::YUVToRGBManager::kScaleITU, y, u, v, kYUVWidth, kYUVHeight, kYUVWidth, kYUVWidth + 1);
+		clock_t time410 = clock() - start;
+
+		printf("  %dx%d to %d bpp, %d frames: 444 %ld ms, 420 %ld ms, 410 %ld ms\n",
+			kYUVWidth, kYUVHeight, formats[i].bytesPerPixel * 8, kYUVIterations,
+			toMilliseconds(time444), toMilliseconds(time420), toMilliseconds(time410));
+
+		surface.free();
+	}
+
+	delete[] y;
+	delete[] u;
+	delete[] v;
+}
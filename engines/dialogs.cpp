@@ -230,6 +230,8 @@ void MainMenuDialog::save() {
 				  "instructions on how to obtain further assistance."), status.getDesc().c_str());
 			GUI::MessageDialog dialog(failMessage);
 			dialog.runModal();
+		} else {
+			_saveDialog->updateMetaInfos(slot, result);
 		}
 
 		close();
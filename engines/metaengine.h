@@ -169,6 +169,20 @@ public:
 		return SaveStateDescriptor();
 	}
 
+	/**
+	 * Returns the name of the savefile holding the specified save state.
+	 *
+	 * This lets the save/load dialogs cache the meta infos of the save
+	 * state until that file is written or removed. Engines returning an
+	 * empty string, which is the default, are not cached.
+	 *
+	 * @param target	name of a config manager target
+	 * @param slot		slot number of the save state
+	 */
+	virtual Common::String getSavefileName(const char *target, int slot) const {
+		return Common::String();
+	}
+
 	/** @name MetaEngineFeature flags */
 	//@{
 
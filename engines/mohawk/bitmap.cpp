@@ -36,6 +36,37 @@ namespace Mohawk {
 #define PACK_COMPRESSION (_header.format & kPackMASK)
 #define DRAW_COMPRESSION (_header.format & kDrawMASK)
 
+// The decoders read whole commands without checking for the end of the
+// input, so it is followed by enough zero bytes for the longest command.
+// Those act like the reads past the end of a stream, which return 0.
+static const uint32 kInputPadding = 256;
+
+// Reads the rest of a stream into a contiguous, zero padded buffer
+static byte *readInputData(Common::SeekableReadStream *stream, uint32 &size) {
+	size = stream->size() - stream->pos();
+	byte *data = (byte *)malloc(size + kInputPadding);
+	size = stream->read(data, size);
+	memset(data + size, 0, kInputPadding);
+	return data;
+}
+
+// Copies a back-reference, with the result of copying it byte by byte.
+// When the source overlaps the destination, the bytes between them are
+// repeated, and each copy doubles the length of the repeated part.
+static inline void copyBackReference(byte *dst, const byte *src, uint32 len) {
+	if (src >= dst || (uint32)(dst - src) >= len) {
+		memmove(dst, src, len);
+		return;
+	}
+
+	while (len > 0) {
+		uint32 n = MIN<uint32>(len, dst - src);
+		memcpy(dst, src, n);
+		dst += n;
+		len -= n;
+	}
+}
+
 MohawkBitmap::MohawkBitmap() {
 	static const PackFunction packTable[] = {
 		{ kPackNone, "Raw", &MohawkBitmap::unpackRaw },
@@ -222,6 +253,12 @@ Common::SeekableReadStream *MohawkBitmap::decompressLZ(Common::SeekableReadStrea
 	uint32 bytesOut = 0;
 	uint16 insertPos = 0;
 
+	uint32 startPos = stream->pos();
+	uint32 inputSize;
+	byte *inputData = readInputData(stream, inputSize);
+	const byte *src = inputData;
+	const byte *srcEnd = inputData + inputSize;
+
 	// Expand the output buffer to at least the ring buffer size
 	uint32 outBufSize = MAX<int>(uncompressedSize, CBUFFERSIZE);
 
@@ -232,22 +269,23 @@ Common::SeekableReadStream *MohawkBitmap::decompressLZ(Common::SeekableReadStrea
 	// Clear the buffer to all 0's
 	memset(outputData, 0, outBufSize);
 
-	while (stream->pos() < stream->size()) {
+	while (src < srcEnd) {
 		flags >>= 1;
 
 		if (!(flags & 0x100))
-			flags = stream->readByte() | 0xff00;
+			flags = *src++ | 0xff00;
 
 		if (flags & 1) {
 			if (++bytesOut > uncompressedSize)
 				break;
-			*dst++ = stream->readByte();
+			*dst++ = *src++;
 			if (++insertPos > POS_MASK) {
 				insertPos = 0;
 				buf += CBUFFERSIZE;
 			}
 		} else {
-			uint16 offLen = stream->readUint16BE();
+			uint16 offLen = READ_BE_UINT16(src);
+			src += 2;
 			uint16 stringLen = (offLen >> POS_BITS) + MIN_STRING;
 			uint16 stringPos = (offLen + MAX_STRING) & POS_MASK;
 
@@ -281,14 +319,18 @@ Common::SeekableReadStream *MohawkBitmap::decompressLZ(Common::SeekableReadStrea
 				buf += CBUFFERSIZE;
 			}
 
-			for (uint16 k = 0; k < stringLen; k++)
-				*dst++ = *strPtr++;
+			copyBackReference(dst, strPtr, stringLen);
+			dst += stringLen;
 
 			if (bytesOut >= uncompressedSize)
 				break;
 		}
 	}
 
+	// Leave the stream right after the compressed data
+	stream->seek(startPos + MIN<uint32>(src - inputData, inputSize));
+	free(inputData);
+
 	return new Common::MemoryReadStream(outputData, uncompressedSize, DisposeAfterUse::YES);
 }
 
@@ -314,43 +356,41 @@ void MohawkBitmap::unpackLZ() {
 void MohawkBitmap::unpackRiven() {
 	_data->readUint32BE(); // Unknown, the number is close to bytesPerRow * height. Could be bufSize.
 
-	byte *uncompressedData = (byte *)malloc(_header.bytesPerRow * _header.height);
+	uint32 inputSize;
+	byte *inputData = readInputData(_data, inputSize);
+	const byte *src = inputData;
+	const byte *srcEnd = inputData + inputSize;
+
+	// A single command outputs up to 63 subcommands of 66 pixels each, which
+	// may go past the end of the image if the data is corrupt
+	uint32 uncompressedSize = _header.bytesPerRow * _header.height;
+	byte *uncompressedData = (byte *)malloc(uncompressedSize + 63 * 66);
 	byte *dst = uncompressedData;
 
-	while (!_data->eos() && dst < (uncompressedData + _header.bytesPerRow * _header.height)) {
-		byte cmd = _data->readByte();
+	while (src < srcEnd && dst < (uncompressedData + uncompressedSize)) {
+		byte cmd = *src++;
 		debug (8, "Riven Pack Command %02x", cmd);
 
 		if (cmd == 0x00) {                       // End of stream
 			break;
 		} else if (cmd >= 0x01 && cmd <= 0x3f) { // Simple Pixel Duplet Output
-			for (byte i = 0; i < cmd; i++) {
-				*dst++ = _data->readByte();
-				*dst++ = _data->readByte();
-			}
+			memcpy(dst, src, cmd * 2);
+			dst += cmd * 2;
+			src += cmd * 2;
 		} else if (cmd >= 0x40 && cmd <= 0x7f) { // Simple Repetition of last 2 pixels (cmd - 0x40) times
-			byte pixel[] = { *(dst - 2), *(dst - 1) };
-
-			for (byte i = 0; i < (cmd - 0x40); i++) {
-				*dst++ = pixel[0];
-				*dst++ = pixel[1];
-			}
+			copyBackReference(dst, dst - 2, (cmd - 0x40) * 2);
+			dst += (cmd - 0x40) * 2;
 		} else if (cmd >= 0x80 && cmd <= 0xbf) { // Simple Repetition of last 4 pixels (cmd - 0x80) times
-			byte pixel[] = { *(dst - 4), *(dst - 3), *(dst - 2), *(dst - 1) };
-
-			for (byte i = 0; i < (cmd - 0x80); i++) {
-				*dst++ = pixel[0];
-				*dst++ = pixel[1];
-				*dst++ = pixel[2];
-				*dst++ = pixel[3];
-			}
+			copyBackReference(dst, dst - 4, (cmd - 0x80) * 4);
+			dst += (cmd - 0x80) * 4;
 		} else {                                 // Subcommand Stream of (cmd - 0xc0) subcommands
-			handleRivenSubcommandStream(cmd - 0xc0, dst);
+			handleRivenSubcommandStream(cmd - 0xc0, dst, src);
 		}
 	}
 
+	free(inputData);
 	delete _data;
-	_data = new Common::MemoryReadStream(uncompressedData, _header.bytesPerRow * _header.height, DisposeAfterUse::YES);
+	_data = new Common::MemoryReadStream(uncompressedData, uncompressedSize, DisposeAfterUse::YES);
 }
 
 static byte getLastTwoBits(byte c) {
@@ -366,7 +406,7 @@ static byte getLastFourBits(byte c) {
 }
 
 #define B_BYTE()				\
-	*dst = _data->readByte();	\
+	*dst = *src++;				\
 	dst++
 
 #define B_LASTDUPLET()			\
@@ -394,18 +434,16 @@ static byte getLastFourBits(byte c) {
 	dst++
 
 #define B_NDUPLETS(n)													\
-	uint16 m1 = ((getLastTwoBits(cmd) << 8) + _data->readByte());		\
-		for (uint16 j = 0; j < (n); j++) {								\
-			*dst = *(dst - m1);											\
-			dst++;														\
-		}																\
+	uint16 m1 = ((getLastTwoBits(cmd) << 8) + *src++);					\
+		copyBackReference(dst, dst - m1, (n));							\
+		dst += (n);														\
 		void dummyFuncToAllowTrailingSemicolon()
 
 
 
-void MohawkBitmap::handleRivenSubcommandStream(byte count, byte *&dst) {
+void MohawkBitmap::handleRivenSubcommandStream(byte count, byte *&dst, const byte *&src) {
 	for (byte i = 0; i < count; i++) {
-		byte cmd = _data->readByte();
+		byte cmd = *src++;
 		uint16 m = getLastFourBits(cmd);
 		debug (9, "Riven Pack Subcommand %02x", cmd);
 
@@ -473,13 +511,13 @@ void MohawkBitmap::handleRivenSubcommandStream(byte count, byte *&dst) {
 		} else if (cmd == 0xa0) {
 			// Repeat last duplet, adding first 4 bits of the next byte
 			// to first pixel and last 4 bits to second
-			byte pattern = _data->readByte();
+			byte pattern = *src++;
 			B_LASTDUPLET_PLUS(pattern >> 4);
 			B_LASTDUPLET_PLUS(getLastFourBits(pattern));
 		} else if (cmd == 0xb0) {
 			// Repeat last duplet, adding first 4 bits of the next byte
 			// to first pixel and subtracting last 4 bits from second
-			byte pattern = _data->readByte();
+			byte pattern = *src++;
 			B_LASTDUPLET_PLUS(pattern >> 4);
 			B_LASTDUPLET_MINUS(getLastFourBits(pattern));
 		} else if (cmd >= 0xc0 && cmd <= 0xcf) {
@@ -493,13 +531,13 @@ void MohawkBitmap::handleRivenSubcommandStream(byte count, byte *&dst) {
 		} else if (cmd == 0xe0) {
 			// Repeat last duplet, subtracting first 4 bits of the next byte
 			// to first pixel and adding last 4 bits to second
-			byte pattern = _data->readByte();
+			byte pattern = *src++;
 			B_LASTDUPLET_MINUS(pattern >> 4);
 			B_LASTDUPLET_PLUS(getLastFourBits(pattern));
 		} else if (cmd == 0xf0 || cmd == 0xff) {
 			// Repeat last duplet, subtracting first 4 bits from the next byte
 			// to first pixel and last 4 bits from second
-			byte pattern = _data->readByte();
+			byte pattern = *src++;
 			B_LASTDUPLET_MINUS(pattern >> 4);
 			B_LASTDUPLET_MINUS(getLastFourBits(pattern));
 
@@ -535,22 +573,23 @@ void MohawkBitmap::handleRivenSubcommandStream(byte count, byte *&dst) {
 			B_NDUPLETS(13);
 			B_BYTE();
 		} else if (cmd == 0xfc) {
-			byte b1 = _data->readByte();
-			byte b2 = _data->readByte();
+			byte b1 = *src++;
+			byte b2 = *src++;
 			uint16 m1 = ((getLastTwoBits(b1) << 8) + b2);
 
-			for (uint16 j = 0; j < ((b1 >> 3) + 1); j++) { // one less iteration
-				B_PIXEL_MINUS(m1);
-				B_PIXEL_MINUS(m1);
-			}
+			// ((b1 >> 3) + 1) duplets, and the first pixel of the last one
+			uint16 len = ((b1 >> 3) + 1) * 2 + 1;
+
+			// The second pixel of the last duplet is copied as well,
+			// unless it is given as an absolute value
+			if (b1 & (1 << 2))
+				len++;
 
-			// last iteration
-			B_PIXEL_MINUS(m1);
+			copyBackReference(dst, dst - m1, len);
+			dst += len;
 
 			if ((b1 & (1 << 2)) == 0) {
 				B_BYTE();
-			} else {
-				B_PIXEL_MINUS(m1);
 			}
 		} else
 			warning("Unknown Riven Pack Subcommand 0x%02x", cmd);
@@ -564,26 +603,45 @@ void MohawkBitmap::handleRivenSubcommandStream(byte count, byte *&dst) {
 void MohawkBitmap::drawRaw(Graphics::Surface *surface) {
 	assert(surface);
 
-	for (uint16 y = 0; y < _header.height; y++) {
-		if (getBitsPerPixel() == 24) {
-			Graphics::PixelFormat pixelFormat = g_system->getScreenFormat();
+	uint32 inputSize;
+	byte *inputData = readInputData(_data, inputSize);
 
-			for (uint16 x = 0; x < _header.width; x++) {
-				byte b = _data->readByte();
-				byte g = _data->readByte();
-				byte r = _data->readByte();
-				if (surface->format.bytesPerPixel == 2)
-					*((uint16 *)surface->getBasePtr(x, y)) = pixelFormat.RGBToColor(r, g, b);
-				else
-					*((uint32 *)surface->getBasePtr(x, y)) = pixelFormat.RGBToColor(r, g, b);
+	// Missing rows are drawn from zeros, just like reading past the end
+	// of the stream would
+	uint32 rawSize = _header.bytesPerRow * _header.height;
+	if (inputSize < rawSize) {
+		inputData = (byte *)realloc(inputData, rawSize);
+		memset(inputData + inputSize, 0, rawSize - inputSize);
+	}
+
+	const byte *src = inputData;
+
+	if (getBitsPerPixel() == 24) {
+		Graphics::PixelFormat pixelFormat = g_system->getScreenFormat();
+
+		for (uint16 y = 0; y < _header.height; y++) {
+			const byte *pixel = src;
+
+			if (surface->format.bytesPerPixel == 2) {
+				uint16 *dst = (uint16 *)surface->getBasePtr(0, y);
+				for (uint16 x = 0; x < _header.width; x++, pixel += 3)
+					*dst++ = pixelFormat.RGBToColor(pixel[2], pixel[1], pixel[0]);
+			} else {
+				uint32 *dst = (uint32 *)surface->getBasePtr(0, y);
+				for (uint16 x = 0; x < _header.width; x++, pixel += 3)
+					*dst++ = pixelFormat.RGBToColor(pixel[2], pixel[1], pixel[0]);
 			}
 
-			_data->skip(_header.bytesPerRow - _header.width * 3);
-		} else {
-			_data->read((byte *)surface->pixels + y * _header.width, _header.width);
-			_data->skip(_header.bytesPerRow - _header.width);
+			src += _header.bytesPerRow;
+		}
+	} else {
+		for (uint16 y = 0; y < _header.height; y++) {
+			memcpy((byte *)surface->pixels + y * _header.width, src, _header.width);
+			src += _header.bytesPerRow;
 		}
 	}
+
+	free(inputData);
 }
 
 //////////////////////////////////////////
@@ -138,7 +138,7 @@ private:
 	void drawImage(Graphics::Surface *surface);
 
 	// Riven Decoding
-	void handleRivenSubcommandStream(byte count, byte *&dst);
+	void handleRivenSubcommandStream(byte count, byte *&dst, const byte *&src);
 };
 
 #ifdef ENABLE_MYST
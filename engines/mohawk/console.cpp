@@ -305,6 +305,15 @@ bool MystConsole::Cmd_Cache(int argc, const char **argv) {
 	}
 
 	DebugPrintf("Cache: %s\n", state ? "Enabled" : "Disabled");
+
+	const ResourceCache &cache = _vm->getCache();
+	const ResourceCache::Stats &stats = cache.getStats();
+	DebugPrintf("%d resources, %d of %d KB used\n", stats.entries, stats.bytes / 1024, cache.getBudget() / 1024);
+	DebugPrintf("%d hits, %d misses, %d evictions\n", stats.hits, stats.misses, stats.evictions);
+
+	const GraphicsManager::CacheStats &imageStats = _vm->_gfx->getCacheStats();
+	DebugPrintf("Images: %d images, %d of %d KB used\n", imageStats.images, imageStats.bytes / 1024, _vm->_gfx->getCacheBudget() / 1024);
+	DebugPrintf("%d hits, %d misses, %d evictions, %d ms decoding\n", imageStats.hits, imageStats.misses, imageStats.evictions, imageStats.decodeTime);
 	return true;
 }
 
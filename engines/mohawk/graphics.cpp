@@ -24,6 +24,7 @@
 #include "mohawk/resource.h"
 #include "mohawk/graphics.h"
 
+#include "common/debug.h"
 #include "common/system.h"
 #include "engines/util.h"
 #include "graphics/palette.h"
@@ -69,6 +70,9 @@ void MohawkSurface::convertToTrueColor() {
 }
 
 GraphicsManager::GraphicsManager() {
+	_cacheBudget = 32 * 1024 * 1024;
+	_cacheUseCounter = 0;
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -76,8 +80,8 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (Common::HashMap<uint16, CacheEntry>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		delete it->_value.surface;
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface *> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
@@ -86,18 +90,53 @@ void GraphicsManager::clearCache() {
 
 	_cache.clear();
 	_subImageCache.clear();
+	_cacheStats.images = 0;
+	_cacheStats.bytes = 0;
+}
+
+void GraphicsManager::trimCache() {
+	while (_cacheStats.bytes > _cacheBudget) {
+		Common::HashMap<uint16, CacheEntry>::iterator oldest = _cache.begin();
+		for (Common::HashMap<uint16, CacheEntry>::iterator it = _cache.begin(); it != _cache.end(); it++)
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+
+		_cacheStats.bytes -= oldest->_value.size;
+		_cacheStats.images--;
+		_cacheStats.evictions++;
+
+		delete oldest->_value.surface;
+		_cache.erase(oldest);
+	}
+
+	debug(2, "Image cache: %d images, %d KB, %d hits, %d misses, %d evictions, %d ms decoding",
+			_cacheStats.images, _cacheStats.bytes / 1024, _cacheStats.hits,
+			_cacheStats.misses, _cacheStats.evictions, _cacheStats.decodeTime);
+}
+
+uint32 GraphicsManager::getImageSize(MohawkSurface *surface) {
+	uint32 size = surface->getSurface()->pitch * surface->getSurface()->h;
+	if (surface->getPalette())
+		size += 256 * 3;
+	return size;
 }
 
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
-	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+	Common::HashMap<uint16, CacheEntry>::iterator it = _cache.find(id);
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	if (it != _cache.end()) {
+		_cacheStats.hits++;
+		it->_value.lastUse = ++_cacheUseCounter;
+		return it->_value.surface;
+	}
 
-	return _cache[id];
+	uint32 startTime = getVM()->_system->getMillis();
+	MohawkSurface *surface = decodeImage(id);
+	_cacheStats.decodeTime += getVM()->_system->getMillis() - startTime;
+	_cacheStats.misses++;
+
+	addImageToCache(id, surface);
+	return surface;
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -227,7 +266,13 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	CacheEntry &entry = _cache[id];
+	entry.surface = surface;
+	entry.size = getImageSize(surface);
+	entry.lastUse = ++_cacheUseCounter;
+
+	_cacheStats.images++;
+	_cacheStats.bytes += entry.size;
 }
 
 } // End of namespace Mohawk
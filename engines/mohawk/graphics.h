@@ -74,6 +74,21 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Free the least recently used surfaces until the cache fits its budget
+	void trimCache();
+
+	struct CacheStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+		uint32 images;
+		uint32 bytes;
+		uint32 decodeTime; // Total time spent decoding images, in ms
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	uint32 getCacheBudget() const { return _cacheBudget; }
+
 	void preloadImage(uint16 image);
 	virtual void setPalette(uint16 id);
 	void copyAnimImageToScreen(uint16 image, int left = 0, int top = 0);
@@ -97,9 +112,23 @@ protected:
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface *> _cache;
+	struct CacheEntry {
+		MohawkSurface *surface;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	// An image cache that stores images until clearCache() is called, or
+	// until trimCache() evicts them when the cache exceeds its budget.
+	// Images are never evicted while they are being looked up, so surfaces
+	// returned by findImage() remain valid until the next trim.
+	Common::HashMap<uint16, CacheEntry> _cache;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
+	uint32 _cacheBudget;
+	uint32 _cacheUseCounter;
+	CacheStats _cacheStats;
+
+	static uint32 getImageSize(MohawkSurface *surface);
 };
 
 } // End of namespace Mohawk
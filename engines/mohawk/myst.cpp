@@ -564,9 +564,9 @@ void MohawkEngine_Myst::changeToCard(uint16 card, TransitionType transition) {
 
 	unloadCard();
 
-	// Clear the resource cache and image cache
-	_cache.clear();
-	_gfx->clearCache();
+	// Resources and images of the current stack remain cached, the
+	// caches evict the least recently used ones when over budget
+	_gfx->trimCache();
 
 	_curCard = card;
 
@@ -205,6 +205,7 @@ public:
 
 	void setCacheState(bool state) { _cache.enabled = state; }
 	bool getCacheState() { return _cache.enabled; }
+	const ResourceCache &getCache() const { return _cache; }
 
 	GUI::Debugger *getDebugger() { return _console; }
 
@@ -21,13 +21,28 @@
  */
 
 #include "common/debug.h"
+#include "common/memstream.h"
 #include "mohawk/myst.h"
 #include "mohawk/resource_cache.h"
 
 namespace Mohawk {
 
+/**
+ * A read-only view of cached resource data, which keeps the data alive
+ * for as long as the stream exists.
+ */
+class ResourceCache::SharedStream : public Common::MemoryReadStream {
+public:
+	SharedStream(const BufferPtr &buffer) : Common::MemoryReadStream(buffer->data, buffer->size), _buffer(buffer) {}
+
+private:
+	BufferPtr _buffer;
+};
+
 ResourceCache::ResourceCache() {
 	enabled = true;
+	_budget = 16 * 1024 * 1024;
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 ResourceCache::~ResourceCache() {
@@ -35,30 +50,74 @@ ResourceCache::~ResourceCache() {
 }
 
 void ResourceCache::clear() {
-	if (!enabled)
-		return;
-
 	debugC(kDebugCache, "Clearing Cache...");
 
-	for (uint32 i = 0; i < _store.size(); i++)
-		delete _store[i].data;
-
 	_store.clear();
+	_usage.clear();
+	_stats.entries = 0;
+	_stats.bytes = 0;
+}
+
+void ResourceCache::setBudget(uint32 budget) {
+	_budget = budget;
+	evict(_budget);
+}
+
+void ResourceCache::evict(uint32 budget) {
+	while (_stats.bytes > budget && !_usage.empty()) {
+		Key key = _usage.back();
+		_usage.pop_back();
+
+		TypeMap::iterator type = _store.find(key.tag);
+		ResourceMap::iterator resource = type->_value.find(key.id);
+
+		debugC(kDebugCache, "Evicting tag 0x%04X id %d", key.tag, key.id);
+
+		_stats.bytes -= resource->_value.buffer->size;
+		_stats.entries--;
+		_stats.evictions++;
+
+		type->_value.erase(resource);
+		if (type->_value.empty())
+			_store.erase(type);
+	}
 }
 
 void ResourceCache::add(uint32 tag, uint16 id, Common::SeekableReadStream *data) {
 	if (!enabled)
 		return;
 
-	debugC(kDebugCache, "Adding item %d - tag 0x%04X id %d", _store.size(), tag, id);
+	if (_store.contains(tag) && _store[tag].contains(id))
+		return;
+
+	uint32 size = data->size();
+	if (size > _budget) {
+		debugC(kDebugCache, "Not caching tag 0x%04X id %d, %d bytes exceed the budget", tag, id, size);
+		return;
+	}
+
+	debugC(kDebugCache, "Adding item %d - tag 0x%04X id %d", _stats.entries, tag, id);
+
+	// Make room before the new data is allocated
+	evict(_budget - size);
 
 	DataObject current;
-	current.tag = tag;
-	current.id = id;
+	current.buffer = BufferPtr(new Buffer(size));
+
 	uint32 dataCurPos = data->pos();
-	current.data = data->readStream(data->size());
+	data->seek(0);
+	data->read(current.buffer->data, size);
 	data->seek(dataCurPos);
-	_store.push_back(current);
+
+	Key key;
+	key.tag = tag;
+	key.id = id;
+	_usage.push_front(key);
+	current.usage = _usage.begin();
+
+	_store[tag][id] = current;
+	_stats.entries++;
+	_stats.bytes += size;
 }
 
 // Returns NULL if not found
@@ -68,17 +127,27 @@ Common::SeekableReadStream *ResourceCache::search(uint32 tag, uint16 id) {
 
 	debugC(kDebugCache, "Searching for tag 0x%04X id %d", tag, id);
 
-	for (uint32 i = 0; i < _store.size(); i++) {
-		if (tag == _store[i].tag && id == _store[i].id) {
+	TypeMap::iterator type = _store.find(tag);
+	if (type != _store.end()) {
+		ResourceMap::iterator resource = type->_value.find(id);
+
+		if (resource != type->_value.end()) {
 			debugC(kDebugCache, "Found cached tag 0x%04X id %u", tag, id);
-			uint32 dataCurPos  = _store[i].data->pos();
-			Common::SeekableReadStream *ret = _store[i].data->readStream(_store[i].data->size());
-			_store[i].data->seek(dataCurPos);
-			return ret;
+			_stats.hits++;
+
+			// Mark the resource as the most recently used one
+			DataObject &object = resource->_value;
+			Key key = *object.usage;
+			_usage.erase(object.usage);
+			_usage.push_front(key);
+			object.usage = _usage.begin();
+
+			return new SharedStream(object.buffer);
 		}
 	}
 
 	debugC(kDebugCache, "tag 0x%04X id %d not found", tag, id);
+	_stats.misses++;
 	return NULL;
 }
 
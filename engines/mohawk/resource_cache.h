@@ -23,11 +23,20 @@
 #ifndef RESOURCE_CACHE_H
 #define RESOURCE_CACHE_H
 
-#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/stream.h"
 
 namespace Mohawk {
 
+/**
+ * Keeps resources in memory once they have been read. Cached resources are
+ * handed out as read-only memory streams which share the cached data, so
+ * they remain valid even when the resource is evicted from the cache. When
+ * the cached data exceeds the memory budget, the least recently used
+ * resources are evicted.
+ */
 class ResourceCache {
 public:
 	ResourceCache();
@@ -41,14 +50,53 @@ public:
 	// Returns NULL if not found
 	Common::SeekableReadStream *search(uint32 tag, uint16 id);
 
+	void setBudget(uint32 budget);
+	uint32 getBudget() const { return _budget; }
+
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+		uint32 entries;
+		uint32 bytes;
+	};
+
+	const Stats &getStats() const { return _stats; }
+
 private:
-	struct DataObject {
+	struct Buffer {
+		Buffer(uint32 s) : data((byte *)malloc(s)), size(s) {}
+		~Buffer() { free(data); }
+
+		byte *data;
+		uint32 size;
+	};
+
+	typedef Common::SharedPtr<Buffer> BufferPtr;
+
+	class SharedStream;
+
+	struct Key {
 		uint32 tag;
 		uint16 id;
-		Common::SeekableReadStream *data;
 	};
 
-	Common::Array<DataObject> _store;
+	typedef Common::List<Key> UsageList;
+
+	struct DataObject {
+		BufferPtr buffer;
+		UsageList::iterator usage;
+	};
+
+	typedef Common::HashMap<uint16, DataObject> ResourceMap;
+	typedef Common::HashMap<uint32, ResourceMap> TypeMap;
+
+	void evict(uint32 budget);
+
+	TypeMap _store;
+	UsageList _usage; // Most recently used first
+	uint32 _budget;
+	Stats _stats;
 };
 
 } // End of namespace Mohawk
@@ -22,8 +22,31 @@
 
 #include "engines/savestate.h"
 #include "graphics/surface.h"
+#include "graphics/thumbnail.h"
+#include "common/stream.h"
 #include "common/textconsole.h"
 
+namespace {
+
+enum {
+	kMetaInfosVersion = 1
+};
+
+void writeMetaInfosString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint16LE(str.size());
+	out.writeString(str);
+}
+
+Common::String readMetaInfosString(Common::SeekableReadStream &in) {
+	Common::String str;
+	uint16 size = in.readUint16LE();
+	while (size-- && !in.eos())
+		str += (char)in.readByte();
+	return str;
+}
+
+} // End of anonymous namespace
+
 SaveStateDescriptor::SaveStateDescriptor()
 	// FIXME: default to 0 (first slot) or to -1 (invalid slot) ?
 	: _slot(-1), _description(), _isDeletable(true), _isWriteProtected(false),
@@ -58,3 +81,42 @@ void SaveStateDescriptor::setPlayTime(uint32 msecs) {
 	uint minutes = msecs / 60000;
 	setPlayTime(minutes / 60, minutes % 60);
 }
+
+bool SaveStateDescriptor::saveMetaInfos(Common::WriteStream &out) const {
+	out.writeByte(kMetaInfosVersion);
+	writeMetaInfosString(out, _description);
+	out.writeByte(_isDeletable ? 1 : 0);
+	out.writeByte(_isWriteProtected ? 1 : 0);
+	writeMetaInfosString(out, _saveDate);
+	writeMetaInfosString(out, _saveTime);
+	writeMetaInfosString(out, _playTime);
+
+	out.writeByte(_thumbnail ? 1 : 0);
+	if (_thumbnail && !Graphics::saveThumbnail(out, *_thumbnail))
+		return false;
+
+	return !out.err();
+}
+
+bool SaveStateDescriptor::loadMetaInfos(Common::SeekableReadStream &in) {
+	if (in.readByte() != kMetaInfosVersion)
+		return false;
+
+	_description = readMetaInfosString(in);
+	_isDeletable = in.readByte() != 0;
+	_isWriteProtected = in.readByte() != 0;
+	_saveDate = readMetaInfosString(in);
+	_saveTime = readMetaInfosString(in);
+	_playTime = readMetaInfosString(in);
+
+	if (in.readByte()) {
+		Graphics::Surface *thumbnail = Graphics::loadThumbnail(in);
+		if (!thumbnail)
+			return false;
+		setThumbnail(thumbnail);
+	} else {
+		setThumbnail(0);
+	}
+
+	return !in.err() && !in.eos();
+}
@@ -28,6 +28,11 @@
 #include "common/ptr.h"
 
 
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+}
+
 namespace Graphics {
 struct Surface;
 }
@@ -159,6 +164,25 @@ public:
 	 */
 	const Common::String &getPlayTime() const { return _playTime; }
 
+	/**
+	 * Writes the description, flags, date, time, play time and thumbnail
+	 * to the given stream, for caching them in the savefile metadata index.
+	 * The save slot is not included.
+	 *
+	 * @param out The stream to write to.
+	 * @return true on success, false otherwise.
+	 */
+	bool saveMetaInfos(Common::WriteStream &out) const;
+
+	/**
+	 * Reads the data written by saveMetaInfos from the given stream.
+	 *
+	 * @param in The stream to read from.
+	 * @return true on success, false if the data is invalid or of an
+	 *         unsupported version.
+	 */
+	bool loadMetaInfos(Common::SeekableReadStream &in);
+
 private:
 	/**
 	 * The saveslot id, as it would be passed to the "-x" command line switch.
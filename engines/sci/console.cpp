@@ -136,6 +136,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("pl",                 WRAP_METHOD(Console, cmdPlaneList));	// alias
 	DCmd_Register("plane_items",        WRAP_METHOD(Console, cmdPlaneItemList));
 	DCmd_Register("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
+	DCmd_Register("frame_stats",        WRAP_METHOD(Console, cmdFrameStats));
 	DCmd_Register("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	DCmd_Register("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
 	// Segments
@@ -373,6 +374,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" window_list / wl - Shows a list of all the windows (ports) in the draw list (SCI0 - SCI1.1)\n");
 	DebugPrintf(" plane_list / pl - Shows a list of all the planes in the draw list (SCI2+)\n");
 	DebugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
+	DebugPrintf(" frame_stats - Shows how many frames were redrawn and how many pixels were copied to the screen (SCI2+)\n");
 	DebugPrintf(" saved_bits - List saved bits on the hunk\n");
 	DebugPrintf(" show_saved_bits - Display saved bits\n");
 	DebugPrintf("\n");
@@ -1647,6 +1649,19 @@ bool Console::cmdPlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdFrameStats(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		_engine->_gfxFrameout->printFrameStats(this);
+	} else {
+		DebugPrintf("This SCI version does not have a frame output\n");
+	}
+#else
+	DebugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdPlaneItemList(int argc, const char **argv) {
 	if (argc != 2) {
 		DebugPrintf("Shows the list of items for a plane\n");
@@ -484,6 +484,7 @@ public:
 	virtual int getMaximumSaveSlot() const;
 	virtual void removeSaveState(const char *target, int slot) const;
 	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
+	Common::String getSavefileName(const char *target, int slot) const;
 };
 
 Common::Language charToScummVMLanguage(const char c) {
@@ -746,6 +747,10 @@ SaveStateList SciMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
+Common::String SciMetaEngine::getSavefileName(const char *target, int slot) const {
+	return Common::String::format("%s.%03d", target, slot);
+}
+
 SaveStateDescriptor SciMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
 	Common::String fileName = Common::String::format("%s.%03d", target, slot);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(fileName);
@@ -127,6 +127,9 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 		g_system->delayMillis(10);
 	}
 
+	// The video was drawn directly on the actual screen
+	g_sci->_gfxScreen->invalidateCopiedScreen();
+
 	delete[] scaleBuffer;
 	delete videoDecoder;
 }
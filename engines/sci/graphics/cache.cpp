@@ -35,7 +35,7 @@
 namespace Sci {
 
 GfxCache::GfxCache(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette)
-	: _resMan(resMan), _screen(screen), _palette(palette) {
+	: _resMan(resMan), _screen(screen), _palette(palette), _viewUseCounter(0) {
 }
 
 GfxCache::~GfxCache() {
@@ -54,13 +54,36 @@ void GfxCache::purgeFontCache() {
 
 void GfxCache::purgeViewCache() {
 	for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
-		delete iter->_value;
-		iter->_value = 0;
+		delete iter->_value.view;
+		iter->_value.view = 0;
 	}
 
 	_cachedViews.clear();
 }
 
+/**
+ * Makes room for another view, by deleting the least recently used views until
+ * both the number of views and the size of their cels are below the limits.
+ * The most recently used view is kept, as callers may still be using it.
+ */
+void GfxCache::evictViews() {
+	uint32 size = 0;
+	for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter)
+		size += iter->_value.view->getBitmapSize();
+
+	while (_cachedViews.size() > 1 && (_cachedViews.size() >= MAX_CACHED_VIEWS || size > MAX_CACHED_VIEW_SIZE)) {
+		ViewCache::iterator oldest = _cachedViews.begin();
+		for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
+			if (iter->_value.lastUsed < oldest->_value.lastUsed)
+				oldest = iter;
+		}
+
+		size -= oldest->_value.view->getBitmapSize();
+		delete oldest->_value.view;
+		_cachedViews.erase(oldest);
+	}
+}
+
 GfxFont *GfxCache::getFont(GuiResourceId fontId) {
 	if (_cachedFonts.size() >= MAX_CACHED_FONTS)
 		purgeFontCache();
@@ -77,13 +100,20 @@ GfxFont *GfxCache::getFont(GuiResourceId fontId) {
 }
 
 GfxView *GfxCache::getView(GuiResourceId viewId) {
-	if (_cachedViews.size() >= MAX_CACHED_VIEWS)
-		purgeViewCache();
+	ViewCache::iterator iter = _cachedViews.find(viewId);
 
-	if (!_cachedViews.contains(viewId))
-		_cachedViews[viewId] = new GfxView(_resMan, _screen, _palette, viewId);
+	if (iter == _cachedViews.end()) {
+		evictViews();
+
+		CachedView cachedView;
+		cachedView.view = new GfxView(_resMan, _screen, _palette, viewId);
+		cachedView.lastUsed = ++_viewUseCounter;
+		_cachedViews[viewId] = cachedView;
+		return cachedView.view;
+	}
 
-	return _cachedViews[viewId];
+	iter->_value.lastUsed = ++_viewUseCounter;
+	return iter->_value.view;
 }
 
 int16 GfxCache::kernelViewGetCelWidth(GuiResourceId viewId, int16 loopNo, int16 celNo) {
@@ -30,8 +30,13 @@ namespace Sci {
 class GfxFont;
 class GfxView;
 
+struct CachedView {
+	GfxView *view;
+	uint32 lastUsed;
+};
+
 typedef Common::HashMap<int, GfxFont *> FontCache;
-typedef Common::HashMap<int, GfxView *> ViewCache;
+typedef Common::HashMap<int, CachedView> ViewCache;
 
 /**
  * Cache class, handles caching of views/fonts
@@ -54,6 +59,7 @@ public:
 private:
 	void purgeFontCache();
 	void purgeViewCache();
+	void evictViews();
 
 	ResourceManager *_resMan;
 	GfxScreen *_screen;
@@ -61,6 +67,7 @@ private:
 
 	FontCache _cachedFonts;
 	ViewCache _cachedViews;
+	uint32 _viewUseCounter;
 };
 
 } // End of namespace Sci
@@ -66,6 +66,11 @@ GfxFrameout::GfxFrameout(SegManager *segMan, ResourceManager *resMan, GfxCoordAd
 	_curScrollText = -1;
 	_showScrollText = false;
 	_maxScrollTexts = 0;
+	_frameCount = 0;
+	memset(&_framePalette, 0, sizeof(_framePalette));
+	_redrawCount = 0;
+	_lastCopiedPixels = 0;
+	_maxCopiedPixels = 0;
 }
 
 GfxFrameout::~GfxFrameout() {
@@ -549,6 +554,108 @@ void GfxFrameout::showVideo() {
 
 		g_system->delayMillis(10);
 	}
+
+	// The video was drawn directly on the actual screen
+	_screen->invalidateCopiedScreen();
+}
+
+/**
+ * Creates the item lists of all visible planes, and collects everything that
+ * affects how planes and screen items are drawn. Returns true if this differs
+ * from the last frame, or if something may have changed that can't be tracked.
+ */
+bool GfxFrameout::updateFrameState() {
+	Common::Array<uint32> state;
+	bool forceRedraw = false;
+
+	// Remapped colors depend on what is drawn below them
+	if (_palette->isRemapping())
+		forceRedraw = true;
+
+	// Drawing a picture sets its palette again. If the palette was changed
+	// since the last frame was drawn, e.g. by the scripts, it needs redoing.
+	Palette palette;
+	_palette->getSys(&palette);
+	if (memcmp(palette.colors, _framePalette.colors, sizeof(palette.colors)) ||
+		memcmp(palette.intensity, _framePalette.intensity, sizeof(palette.intensity)))
+		forceRedraw = true;
+
+	_planeItemLists.clear();
+
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
+		int16 planePriority = readSelectorValue(_segMan, it->object, SELECTOR(priority));
+
+		state.push_back(it->object.getOffset() | (it->object.getSegment() << 16));
+		state.push_back((uint16)planePriority);
+		state.push_back(it->pictureId);
+		state.push_back((uint16)it->planeRect.left | ((uint16)it->planeRect.top << 16));
+		state.push_back((uint16)it->planeRect.right | ((uint16)it->planeRect.bottom << 16));
+		state.push_back((uint16)it->planeOffsetX | ((uint16)it->planeOffsetY << 16));
+		state.push_back(it->planePictureMirrored | (it->planeBack << 8));
+
+		for (PlaneLineList::iterator it2 = it->lines.begin(); it2 != it->lines.end(); ++it2) {
+			state.push_back((uint16)it2->startPoint.x | ((uint16)it2->startPoint.y << 16));
+			state.push_back((uint16)it2->endPoint.x | ((uint16)it2->endPoint.y << 16));
+			state.push_back(it2->color | (it2->priority << 8) | (it2->control << 16));
+		}
+
+		_planeItemLists.push_back(FrameoutList());
+
+		// Screen items of hidden planes are neither updated nor drawn
+		if (planePriority < 0)
+			continue;
+
+		FrameoutList &itemList = _planeItemLists.back();
+		createPlaneItemList(it->object, itemList);
+
+		for (FrameoutList::iterator listIterator = itemList.begin(); listIterator != itemList.end(); listIterator++) {
+			FrameoutEntry *itemEntry = *listIterator;
+
+			// Picture cels are covered by the plane pictures below
+			if (itemEntry->object.isNull())
+				continue;
+
+			state.push_back(itemEntry->object.getOffset() | (itemEntry->object.getSegment() << 16));
+			state.push_back(itemEntry->givenOrderNr | (itemEntry->viewId << 16));
+			state.push_back((uint16)itemEntry->loopNo | ((uint16)itemEntry->celNo << 16));
+			state.push_back((uint16)itemEntry->x | ((uint16)itemEntry->y << 16));
+			state.push_back((uint16)itemEntry->z | ((uint16)itemEntry->priority << 16));
+			state.push_back(itemEntry->signal | (itemEntry->scaleSignal << 16));
+			state.push_back((uint16)itemEntry->scaleX | ((uint16)itemEntry->scaleY << 16));
+			state.push_back(itemEntry->visible);
+
+			if (readSelectorValue(_segMan, itemEntry->object, SELECTOR(useInsetRect))) {
+				state.push_back(readSelectorValue(_segMan, itemEntry->object, SELECTOR(inLeft)) | (readSelectorValue(_segMan, itemEntry->object, SELECTOR(inTop)) << 16));
+				state.push_back(readSelectorValue(_segMan, itemEntry->object, SELECTOR(inRight)) | (readSelectorValue(_segMan, itemEntry->object, SELECTOR(inBottom)) << 16));
+			}
+
+			// Global scaling depends on the room's vanishing point
+			if ((itemEntry->scaleSignal & kScaleSignalDoScaling32) && !(itemEntry->scaleSignal & kScaleSignalDisableGlobalScaling32)) {
+				reg_t globalVar2 = g_sci->getEngineState()->variables[VAR_GLOBAL][2];
+				state.push_back(readSelectorValue(_segMan, itemEntry->object, SELECTOR(maxScale)) | (readSelectorValue(_segMan, globalVar2, SELECTOR(vanishingY)) << 16));
+			}
+
+			// Text bitmaps can be changed without changing any of the selectors
+			if (itemEntry->visible && lookupSelector(_segMan, itemEntry->object, SELECTOR(text), NULL, NULL) == kSelectorVariable)
+				forceRedraw = true;
+		}
+
+		for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
+			if (pictureIt->object == it->object) {
+				state.push_back(pictureIt->pictureId);
+				state.push_back((uint16)pictureIt->startX | ((uint16)pictureIt->startY << 16));
+			}
+		}
+	}
+
+	state.push_back(_showScrollText | ((uint16)_curScrollText << 16));
+	state.push_back(_scrollTexts.size());
+
+	bool changed = forceRedraw || state.size() != _frameState.size() ||
+		(state.size() > 0 && memcmp(&state[0], &_frameState[0], state.size() * sizeof(uint32)));
+	_frameState = state;
+
+	return changed;
 }
 
 void GfxFrameout::createPlaneItemList(reg_t planeObject, FrameoutList &itemList) {
@@ -651,7 +758,32 @@ void GfxFrameout::kernelFrameout() {
 
 	_palette->palVaryUpdate();
 
-	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
+	_frameCount++;
+
+	// Skip drawing the frame if none of the planes and screen items changed. Any
+	// changes made directly to the screen are still copied below.
+	if (!updateFrameState()) {
+		for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
+			if (it->priority >= 0 && it->pictureId != 0xFFFF)
+				_palette->drewPicture(it->pictureId);
+		}
+
+		for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
+			delete[] pictureIt->pictureCels;
+			pictureIt->pictureCels = 0;
+		}
+		_planeItemLists.clear();
+
+		_lastCopiedPixels = _screen->copyChangedToScreen();
+		_maxCopiedPixels = MAX(_maxCopiedPixels, _lastCopiedPixels);
+		g_sci->getEngineState()->_throttleTrigger = true;
+		return;
+	}
+
+	_redrawCount++;
+
+	uint planeNr = 0;
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++, planeNr++) {
 		reg_t planeObject = it->object;
 
 		// Draw any plane lines, if they exist
@@ -695,9 +827,8 @@ void GfxFrameout::kernelFrameout() {
 		if (it->pictureId != 0xFFFF)
 			_palette->drewPicture(it->pictureId);
 
-		FrameoutList itemList;
-
-		createPlaneItemList(planeObject, itemList);
+		// The item list was created by updateFrameState()
+		FrameoutList &itemList = _planeItemLists[planeNr];
 
 		for (FrameoutList::iterator listIterator = itemList.begin(); listIterator != itemList.end(); listIterator++) {
 			FrameoutEntry *itemEntry = *listIterator;
@@ -830,9 +961,13 @@ void GfxFrameout::kernelFrameout() {
 		}
 	}
 
+	_planeItemLists.clear();
+	_palette->getSys(&_framePalette);
+
 	showCurrentScrollText();
 
-	_screen->copyToScreen();
+	_lastCopiedPixels = _screen->copyChangedToScreen();
+	_maxCopiedPixels = MAX(_maxCopiedPixels, _lastCopiedPixels);
 
 	g_sci->getEngineState()->_throttleTrigger = true;
 }
@@ -887,4 +1022,10 @@ void GfxFrameout::printPlaneItemList(Console *con, reg_t planeObject) {
 	}
 }
 
+void GfxFrameout::printFrameStats(Console *con) {
+	con->DebugPrintf("%d frames, %d of them redrawn\n", _frameCount, _redrawCount);
+	con->DebugPrintf("Pixels copied to the screen: %d for the last frame, %d at most (screen size %d)\n",
+						_lastCopiedPixels, _maxCopiedPixels, _screen->getDisplayWidth() * _screen->getDisplayHeight());
+}
+
 } // End of namespace Sci
@@ -150,9 +150,11 @@ public:
 
 	void printPlaneList(Console *con);
 	void printPlaneItemList(Console *con, reg_t planeObject);
+	void printFrameStats(Console *con);
 
 private:
 	void showVideo();
+	bool updateFrameState();
 	void createPlaneItemList(reg_t planeObject, FrameoutList &itemList);
 	bool isPictureOutOfView(FrameoutEntry *itemEntry, Common::Rect planeRect, int16 planeOffsetX, int16 planeOffsetY);
 	void drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int16 planeOffsetY, bool planePictureMirrored);
@@ -173,6 +175,29 @@ private:
 	bool _showScrollText;
 	uint16 _maxScrollTexts;
 
+	/**
+	 * Everything which affects how the planes and screen items are drawn,
+	 * as it was for the last frame. Nothing is redrawn if it didn't change.
+	 */
+	Common::Array<uint32> _frameState;
+
+	/**
+	 * The system palette after the last frame was drawn.
+	 */
+	Palette _framePalette;
+
+	/**
+	 * The item lists of the planes, created by updateFrameState() and drawn
+	 * by kernelFrameout().
+	 */
+	Common::Array<FrameoutList> _planeItemLists;
+
+	// Statistics for the "frame_stats" console command
+	uint32 _frameCount;
+	uint32 _redrawCount;
+	uint32 _lastCopiedPixels;
+	uint32 _maxCopiedPixels;
+
 	void sortPlanes();
 };
 
@@ -120,6 +120,9 @@ GfxScreen::GfxScreen(ResourceManager *resMan) : _resMan(resMan) {
 	// Sets display screen to be actually displayed
 	_activeScreen = _displayScreen;
 
+	_copiedScreen = 0;
+	_copiedScreenValid = false;
+
 	_picNotValid = 0;
 	_picNotValidSci11 = 0;
 	_unditheringEnabled = true;
@@ -161,12 +164,65 @@ GfxScreen::~GfxScreen() {
 	free(_priorityScreen);
 	free(_controlScreen);
 	free(_displayScreen);
+	free(_copiedScreen);
 }
 
 void GfxScreen::copyToScreen() {
 	g_system->copyRectToScreen(_activeScreen, _displayWidth, 0, 0, _displayWidth, _displayHeight);
 }
 
+uint32 GfxScreen::copyChangedToScreen() {
+	if (!_copiedScreen)
+		_copiedScreen = (byte *)malloc(_displayPixels);
+
+	if (!_copiedScreenValid) {
+		copyToScreen();
+		memcpy(_copiedScreen, _activeScreen, _displayPixels);
+		_copiedScreenValid = true;
+		return _displayPixels;
+	}
+
+	// Copy each run of changed lines, limited to the columns which changed
+	uint32 pixelCount = 0;
+	int y = 0;
+
+	while (y < _displayHeight) {
+		int top = y;
+		int left = _displayWidth;
+		int right = 0;
+
+		for (; y < _displayHeight; y++) {
+			const byte *line = _activeScreen + y * _displayWidth;
+			const byte *copiedLine = _copiedScreen + y * _displayWidth;
+
+			if (!memcmp(line, copiedLine, _displayWidth))
+				break;
+
+			int lineLeft = 0;
+			while (line[lineLeft] == copiedLine[lineLeft])
+				lineLeft++;
+			int lineRight = _displayWidth;
+			while (line[lineRight - 1] == copiedLine[lineRight - 1])
+				lineRight--;
+
+			left = MIN(left, lineLeft);
+			right = MAX(right, lineRight);
+		}
+
+		if (y > top) {
+			g_system->copyRectToScreen(_activeScreen + top * _displayWidth + left, _displayWidth, left, top, right - left, y - top);
+			for (int i = top; i < y; i++)
+				memcpy(_copiedScreen + i * _displayWidth + left, _activeScreen + i * _displayWidth + left, right - left);
+			pixelCount += (right - left) * (y - top);
+		}
+
+		// Skip the unchanged line
+		y++;
+	}
+
+	return pixelCount;
+}
+
 void GfxScreen::copyFromScreen(byte *buffer) {
 	// TODO this ignores the pitch
 	Graphics::Surface *screen = g_system->lockScreen();
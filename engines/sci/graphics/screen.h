@@ -79,6 +79,17 @@ public:
 	void copyDisplayRectToScreen(const Common::Rect &rect);
 	void copyRectToScreen(const Common::Rect &rect, int16 x, int16 y);
 
+	/**
+	 * Copies the lines of the active screen which changed since the last call
+	 * to the actual screen, and returns the number of pixels which were copied.
+	 */
+	uint32 copyChangedToScreen();
+	/**
+	 * Makes the next copyChangedToScreen() copy the whole screen. Needed after
+	 * something else got drawn directly on the actual screen, e.g. a video.
+	 */
+	void invalidateCopiedScreen() { _copiedScreenValid = false; }
+
 	byte getDrawingMask(byte color, byte prio, byte control);
 	void putPixel(int x, int y, byte drawMask, byte color, byte prio, byte control);
 	void putFontPixel(int startingY, int x, int y, byte color);
@@ -177,6 +188,12 @@ private:
 	 */
 	byte *_activeScreen;
 
+	/**
+	 * A copy of the active screen, as it was last copied by copyChangedToScreen().
+	 */
+	byte *_copiedScreen;
+	bool _copiedScreenValid;
+
 	/**
 	 * This variable defines, if upscaled hires is active and what upscaled mode
 	 * is used.
@@ -48,6 +48,9 @@ GfxView::~GfxView() {
 	}
 	delete[] _loop;
 
+	for (uint i = 0; i < _scaledCels.size(); i++)
+		delete[] _scaledCels[i].bitmap;
+
 	_resMan->unlockResource(_resource);
 }
 
@@ -82,6 +85,7 @@ void GfxView::initData(GuiResourceId resourceId) {
 	_EGAmapping = NULL;
 	_sci2ScaleRes = SCI_VIEW_NATIVERES_NONE;
 	_isScaleable = true;
+	_bitmapSize = 0;
 
 	// we adjust inside getCelRect for SCI0EARLY (that version didn't have the +1 when calculating bottom)
 	_adjustForSci0Early = getSciVersion() == SCI_VERSION_0_EARLY ? -1 : 0;
@@ -591,6 +595,7 @@ const byte *GfxView::getBitmap(int16 loopNo, int16 celNo) {
 	int pixelCount = width * height;
 	_loop[loopNo].cel[celNo].rawBitmap = new byte[pixelCount];
 	byte *pBitmap = _loop[loopNo].cel[celNo].rawBitmap;
+	_bitmapSize += pixelCount;
 
 	// unpack the actual cel bitmap data
 	unpackCel(loopNo, celNo, pBitmap, pixelCount);
@@ -776,28 +781,39 @@ void GfxView::draw(const Common::Rect &rect, const Common::Rect &clipRect, const
 }
 
 /**
- * We don't fully follow sierra sci here, I did the scaling algo myself and it
- * is definitely not pixel-perfect with the one sierra is using. It shouldn't
- * matter because the scaled cel rect is definitely the same as in sierra sci.
+ * Returns the cel resampled to the given scaling. Scaled actors get redrawn
+ * constantly, so the last few scaled cels are kept.
  */
-void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect, const Common::Rect &clipRectTranslated,
-			int16 loopNo, int16 celNo, byte priority, int16 scaleX, int16 scaleY) {
-	const Palette *palette = _embeddedPal ? &_viewPalette : &_palette->_sysPalette;
+const ScaledCelInfo &GfxView::getScaledCel(int16 loopNo, int16 celNo, int16 scaleX, int16 scaleY) {
+	for (uint i = 0; i < _scaledCels.size(); i++) {
+		const ScaledCelInfo &scaledCel = _scaledCels[i];
+		if (scaledCel.loopNo == loopNo && scaledCel.celNo == celNo && scaledCel.scaleX == scaleX && scaledCel.scaleY == scaleY) {
+			if (i > 0) {
+				// Move it to the front
+				ScaledCelInfo found = scaledCel;
+				_scaledCels.remove_at(i);
+				_scaledCels.insert_at(0, found);
+			}
+			return _scaledCels[0];
+		}
+	}
+
+	if (_scaledCels.size() >= SCI_VIEW_SCALEDCEL_COUNT) {
+		ScaledCelInfo &oldest = _scaledCels.back();
+		_bitmapSize -= oldest.width * oldest.height;
+		delete[] oldest.bitmap;
+		_scaledCels.pop_back();
+	}
+
 	const CelInfo *celInfo = getCelInfo(loopNo, celNo);
 	const byte *bitmap = getBitmap(loopNo, celNo);
 	const int16 celHeight = celInfo->height;
 	const int16 celWidth = celInfo->width;
-	const byte clearKey = celInfo->clearKey;
-	const byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL|GFX_SCREEN_MASK_PRIORITY;
 	uint16 scalingX[640];
 	uint16 scalingY[480];
 	int16 scaledWidth, scaledHeight;
 	int pixelNo, scaledPixel, scaledPixelNo, prevScaledPixelNo;
 
-	if (_embeddedPal)
-		// Merge view palette in...
-		_palette->set(&_viewPalette, false);
-
 	scaledWidth = (celInfo->width * scaleX) >> 7;
 	scaledHeight = (celInfo->height * scaleY) >> 7;
 	scaledWidth = CLIP<int16>(scaledWidth, 0, _screen->getWidth());
@@ -839,8 +855,44 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	for (; scaledPixelNo < scaledWidth; scaledPixelNo++)
 		scalingX[scaledPixelNo] = pixelNo;
 
-	scaledWidth = MIN(clipRect.width(), scaledWidth);
-	scaledHeight = MIN(clipRect.height(), scaledHeight);
+	ScaledCelInfo scaledCel;
+	scaledCel.loopNo = loopNo;
+	scaledCel.celNo = celNo;
+	scaledCel.scaleX = scaleX;
+	scaledCel.scaleY = scaleY;
+	scaledCel.width = scaledWidth;
+	scaledCel.height = scaledHeight;
+	scaledCel.bitmap = new byte[scaledWidth * scaledHeight];
+	_bitmapSize += scaledWidth * scaledHeight;
+
+	byte *scaledBitmap = scaledCel.bitmap;
+	for (int y = 0; y < scaledHeight; y++) {
+		const byte *line = bitmap + scalingY[y] * celWidth;
+		for (int x = 0; x < scaledWidth; x++)
+			*scaledBitmap++ = line[scalingX[x]];
+	}
+
+	_scaledCels.insert_at(0, scaledCel);
+	return _scaledCels[0];
+}
+
+/**
+ * We don't fully follow sierra sci here, I did the scaling algo myself and it
+ * is definitely not pixel-perfect with the one sierra is using. It shouldn't
+ * matter because the scaled cel rect is definitely the same as in sierra sci.
+ */
+void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect, const Common::Rect &clipRectTranslated,
+			int16 loopNo, int16 celNo, byte priority, int16 scaleX, int16 scaleY) {
+	const Palette *palette = _embeddedPal ? &_viewPalette : &_palette->_sysPalette;
+	const CelInfo *celInfo = getCelInfo(loopNo, celNo);
+	const byte clearKey = celInfo->clearKey;
+	const byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL|GFX_SCREEN_MASK_PRIORITY;
+
+	if (_embeddedPal)
+		// Merge view palette in...
+		_palette->set(&_viewPalette, false);
+
+	const ScaledCelInfo &scaledCel = getScaledCel(loopNo, celNo, scaleX, scaleY);
 
 	const int16 offsetY = clipRect.top - rect.top;
 	const int16 offsetX = clipRect.left - rect.left;
@@ -849,11 +901,13 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	if (offsetX < 0 || offsetY < 0)
 		return;
 
-	assert(scaledHeight + offsetY <= ARRAYSIZE(scalingY));
-	assert(scaledWidth + offsetX <= ARRAYSIZE(scalingX));
+	const int16 scaledWidth = MIN<int16>(clipRect.width(), scaledCel.width - offsetX);
+	const int16 scaledHeight = MIN<int16>(clipRect.height(), scaledCel.height - offsetY);
+
 	for (int y = 0; y < scaledHeight; y++) {
+		const byte *line = scaledCel.bitmap + (y + offsetY) * scaledCel.width + offsetX;
 		for (int x = 0; x < scaledWidth; x++) {
-			const byte color = bitmap[scalingY[y + offsetY] * celWidth + scalingX[x + offsetX]];
+			const byte color = line[x];
 			const int x2 = clipRectTranslated.left + x;
 			const int y2 = clipRectTranslated.top + y;
 			if (color != clearKey && priority >= _screen->getPriority(x2, y2)) {
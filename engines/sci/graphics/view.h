@@ -50,6 +50,19 @@ struct LoopInfo {
 	CelInfo *cel;
 };
 
+/**
+ * A cel which was resampled by drawScaled(). Mirrored cels are already
+ * mirrored in their loop's bitmaps, so they need no separate key.
+ */
+struct ScaledCelInfo {
+	int16 loopNo, celNo;
+	int16 scaleX, scaleY;
+	int16 width, height;
+	byte *bitmap;
+};
+
+#define SCI_VIEW_SCALEDCEL_COUNT 4
+
 #define SCI_VIEW_EGAMAPPING_SIZE 16
 #define SCI_VIEW_EGAMAPPING_COUNT 8
 
@@ -87,10 +100,16 @@ public:
 
 	byte getColorAtCoordinate(int16 loopNo, int16 celNo, int16 x, int16 y);
 
+	/**
+	 * Returns the number of bytes allocated for unpacked and scaled cels.
+	 */
+	uint32 getBitmapSize() const { return _bitmapSize; }
+
 private:
 	void initData(GuiResourceId resourceId);
 	void unpackCel(int16 loopNo, int16 celNo, byte *outPtr, uint32 pixelCount);
 	void unditherBitmap(byte *bitmap, int16 width, int16 height, byte clearKey);
+	const ScaledCelInfo &getScaledCel(int16 loopNo, int16 celNo, int16 scaleX, int16 scaleY);
 
 	ResourceManager *_resMan;
 	GfxCoordAdjuster *_coordAdjuster;
@@ -118,6 +137,10 @@ private:
 	// this is not set for some views in laura bow 2 floppy and signals that the view shall never get scaled
 	//  even if scaleX/Y are set (inside kAnimate)
 	bool _isScaleable;
+
+	// The most recently scaled cels, the most recently used one first
+	Common::Array<ScaledCelInfo> _scaledCels;
+	uint32 _bitmapSize;
 };
 
 } // End of namespace Sci
@@ -30,6 +30,7 @@
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
 #include "scumm/imuse/imuse.h"
+#include "scumm/imuse_digi/dimuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
@@ -155,6 +156,21 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 				DebugPrintf("Specify a music resource # or \"all\".\n");
 			}
 			return true;
+#ifdef ENABLE_SCUMM_7_8
+		} else if (!strcmp(argv[1], "cache") && _vm->_imuseDigital) {
+			BundleBlockCache *cache = _vm->_imuseDigital->getBundleBlockCache();
+			if (argc > 2 && !strcmp(argv[2], "reset")) {
+				cache->resetStats();
+				DebugPrintf("Bundle block cache statistics reset.\n");
+				return true;
+			}
+			BundleBlockCache::Stats stats = cache->getStats();
+			uint32 requests = stats.hits + stats.misses;
+			DebugPrintf("Bundle block cache: %d/%d blocks in use\n", cache->getNumCachedBlocks(), BundleBlockCache::kMaxBlocks);
+			DebugPrintf("  hits: %d, misses: %d, hit rate: %d%%\n", stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0);
+			DebugPrintf("  evictions: %d\n", stats.evictions);
+			return true;
+#endif
 		}
 	}
 
@@ -162,6 +178,10 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 	DebugPrintf("  panic - Stop all music tracks\n");
 	DebugPrintf("  play # - Play a music resource\n");
 	DebugPrintf("  stop # - Stop a music resource\n");
+#ifdef ENABLE_SCUMM_7_8
+	if (_vm->_imuseDigital)
+		DebugPrintf("  cache [reset] - Show (or reset) bundle block cache statistics\n");
+#endif
 	return true;
 }
 
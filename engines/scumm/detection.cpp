@@ -922,6 +922,7 @@ public:
 	virtual int getMaximumSaveSlot() const;
 	virtual void removeSaveState(const char *target, int slot) const;
 	virtual SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
+	virtual Common::String getSavefileName(const char *target, int slot) const;
 };
 
 bool ScummMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -1261,6 +1262,10 @@ void ScummMetaEngine::removeSaveState(const char *target, int slot) const {
 	g_system->getSavefileManager()->removeSavefile(filename);
 }
 
+Common::String ScummMetaEngine::getSavefileName(const char *target, int slot) const {
+	return ScummEngine::makeSavegameName(target, slot, false);
+}
+
 SaveStateDescriptor ScummMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
 	Common::String filename = ScummEngine::makeSavegameName(target, slot, false);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename);
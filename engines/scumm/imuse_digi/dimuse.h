@@ -158,6 +158,8 @@ public:
 	int32 getCurVoiceLipSyncHeight();
 	int32 getCurMusicLipSyncWidth(int syncId);
 	int32 getCurMusicLipSyncHeight(int syncId);
+
+	BundleBlockCache *getBundleBlockCache() { return _sound->getBundleBlockCache(); }
 };
 
 } // End of namespace Scumm
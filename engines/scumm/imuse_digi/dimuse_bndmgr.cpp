@@ -138,14 +138,101 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(BundleDirCache *cache) {
+BundleBlockCache::BundleBlockCache() {
+	for (int i = 0; i < kMaxBlocks; i++)
+		_freeBlocks.push_back(new Block());
+	resetStats();
+}
+
+BundleBlockCache::~BundleBlockCache() {
+	for (BlockList::iterator i = _lru.begin(); i != _lru.end(); ++i)
+		delete *i;
+	for (BlockList::iterator i = _freeBlocks.begin(); i != _freeBlocks.end(); ++i)
+		delete *i;
+}
+
+void BundleBlockCache::insertBlock(Block *block) {
+	_blocks[block->key] = block;
+	_lru.push_front(block);
+	block->lruPos = _lru.begin();
+}
+
+void BundleBlockCache::touchBlock(Block *block) {
+	_lru.erase(block->lruPos);
+	_lru.push_front(block);
+	block->lruPos = _lru.begin();
+}
+
+BundleBlockCache::Block *BundleBlockCache::allocBlock() {
+	Block *block;
+	if (!_freeBlocks.empty()) {
+		block = _freeBlocks.front();
+		_freeBlocks.pop_front();
+	} else {
+		block = _lru.back();
+		_lru.pop_back();
+		_blocks.erase(block->key);
+		_stats.evictions++;
+	}
+	return block;
+}
+
+int32 BundleBlockCache::lookup(int slot, int32 index, int32 block, byte *dst) {
+	Common::StackLock lock(_mutex, "BundleBlockCache::lookup()");
+
+	BlockMap::iterator it = _blocks.find(BlockKey(slot, index, block));
+	if (it == _blocks.end()) {
+		_stats.misses++;
+		return -1;
+	}
+
+	Block *cached = it->_value;
+	_stats.hits++;
+	touchBlock(cached);
+	memcpy(dst, cached->data, cached->size);
+	return cached->size;
+}
+
+void BundleBlockCache::store(int slot, int32 index, int32 block, const byte *src, int32 size) {
+	assert(size >= 0 && size <= kBlockSize);
+	Common::StackLock lock(_mutex, "BundleBlockCache::store()");
+
+	BlockKey key(slot, index, block);
+	if (_blocks.contains(key))
+		return;
+
+	Block *cached = allocBlock();
+	cached->key = key;
+	cached->size = size;
+	memcpy(cached->data, src, size);
+	insertBlock(cached);
+}
+
+BundleBlockCache::Stats BundleBlockCache::getStats() {
+	Common::StackLock lock(_mutex, "BundleBlockCache::getStats()");
+	return _stats;
+}
+
+void BundleBlockCache::resetStats() {
+	Common::StackLock lock(_mutex, "BundleBlockCache::resetStats()");
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+uint32 BundleBlockCache::getNumCachedBlocks() {
+	Common::StackLock lock(_mutex, "BundleBlockCache::getNumCachedBlocks()");
+	return _blocks.size();
+}
+
+BundleMgr::BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache) {
 	_cache = cache;
+	_blockCache = blockCache;
 	_bundleTable = NULL;
 	_compTable = NULL;
 	_numFiles = 0;
 	_numCompItems = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_slot = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
 }
@@ -183,13 +270,13 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 		return false;
 	}
 
-	int slot = _cache->matchFile(filename);
-	assert(slot != -1);
-	compressed = _cache->isSndDataExtComp(slot);
-	_numFiles = _cache->getNumFiles(slot);
+	_slot = _cache->matchFile(filename);
+	assert(_slot != -1);
+	compressed = _cache->isSndDataExtComp(_slot);
+	_numFiles = _cache->getNumFiles(_slot);
 	assert(_numFiles);
-	_bundleTable = _cache->getTable(slot);
-	_indexTable = _cache->getIndexTable(slot);
+	_bundleTable = _cache->getTable(_slot);
+	_indexTable = _cache->getIndexTable(_slot);
 	assert(_bundleTable);
 	_compTableLoaded = false;
 	_outputSize = 0;
@@ -245,6 +332,22 @@ bool BundleMgr::loadCompTable(int32 index) {
 	return true;
 }
 
+void BundleMgr::decodeBlock(int32 index, int32 block) {
+	_outputSize = _blockCache->lookup(_slot, index, block, _compOutputBuff);
+	if (_outputSize >= 0)
+		return;
+
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[block].size);
+	_outputSize = BundleCodecs::decompressCodec(_compTable[block].codec, _compInputBuff, _compOutputBuff, _compTable[block].size);
+	if (_outputSize > 0x2000) {
+		error("_outputSize: %d", _outputSize);
+	}
+	_blockCache->store(_slot, index, block, _compOutputBuff, _outputSize);
+}
+
 int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside);
 }
@@ -287,14 +390,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 	for (i = firstBlock; i <= lastBlock; i++) {
 		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
-			}
+			decodeBlock(index, i);
 			_lastBlock = i;
 		}
 
@@ -24,6 +24,9 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/mutex.h"
 
 namespace Scumm {
 
@@ -63,6 +66,86 @@ public:
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * Bounded LRU cache of decompressed bundle blocks, shared by all BundleMgr
+ * instances. Blocks are keyed by (bundle slot, file index, block number).
+ * Looping music decodes the same blocks over and over, which are then
+ * served from the cache.
+ */
+class BundleBlockCache {
+public:
+	enum {
+		kBlockSize = 0x2000,
+		kMaxBlocks = 64
+	};
+
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
+	BundleBlockCache();
+	~BundleBlockCache();
+
+	/**
+	 * Copy a cached block into dst (which must hold kBlockSize bytes).
+	 * @return	the decoded size of the block, or -1 if it is not cached
+	 */
+	int32 lookup(int slot, int32 index, int32 block, byte *dst);
+
+	/** Store a freshly decoded block, evicting the least recently used one if needed. */
+	void store(int slot, int32 index, int32 block, const byte *src, int32 size);
+
+	Stats getStats();
+	void resetStats();
+	uint32 getNumCachedBlocks();
+
+private:
+	struct BlockKey {
+		int slot;
+		int32 index;
+		int32 block;
+
+		BlockKey() : slot(0), index(0), block(0) {}
+		BlockKey(int s, int32 i, int32 b) : slot(s), index(i), block(b) {}
+	};
+
+	struct BlockKey_Hash {
+		uint operator()(const BlockKey &key) const {
+			return (uint)((key.slot << 28) ^ (key.index << 12) ^ key.block);
+		}
+	};
+
+	struct BlockKey_EqualTo {
+		bool operator()(const BlockKey &x, const BlockKey &y) const {
+			return x.slot == y.slot && x.index == y.index && x.block == y.block;
+		}
+	};
+
+	struct Block;
+	typedef Common::List<Block *> BlockList;
+
+	struct Block {
+		BlockKey key;
+		BlockList::iterator lruPos;
+		int32 size;
+		byte data[kBlockSize];
+	};
+
+	typedef Common::HashMap<BlockKey, Block *, BlockKey_Hash, BlockKey_EqualTo> BlockMap;
+
+	Block *allocBlock();
+	void insertBlock(Block *block);
+	void touchBlock(Block *block);
+
+	Common::Mutex _mutex;
+	BlockMap _blocks;
+	BlockList _lru;			// most recently used at the front
+	BlockList _freeBlocks;
+	Stats _stats;
+};
+
 class BundleMgr {
 
 private:
@@ -74,6 +157,7 @@ private:
 	};
 
 	BundleDirCache *_cache;
+	BundleBlockCache *_blockCache;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable;
 	CompTable *_compTable;
@@ -84,16 +168,18 @@ private:
 	BaseScummFile *_file;
 	bool _compTableLoaded;
 	int _fileBundleId;
+	int _slot;
 	byte _compOutputBuff[0x2000];
 	byte *_compInputBuff;
 	int _outputSize;
 	int _lastBlock;
 
 	bool loadCompTable(int32 index);
+	void decodeBlock(int32 index, int32 block);
 
 public:
 
-	BundleMgr(BundleDirCache *_cache);
+	BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &compressed, bool errorFlag = false);
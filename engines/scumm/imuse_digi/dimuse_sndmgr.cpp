@@ -46,6 +46,8 @@ ImuseDigiSndMgr::ImuseDigiSndMgr(ScummEngine *scumm) {
 	_disk = 0;
 	_cacheBundleDir = new BundleDirCache();
 	assert(_cacheBundleDir);
+	_cacheBundleBlocks = new BundleBlockCache();
+	assert(_cacheBundleBlocks);
 	BundleCodecs::initializeImcTables();
 }
 
@@ -54,6 +56,7 @@ ImuseDigiSndMgr::~ImuseDigiSndMgr() {
 		closeSound(&_sounds[l]);
 	}
 
+	delete _cacheBundleBlocks;
 	delete _cacheBundleDir;
 	BundleCodecs::releaseImcTables();
 }
@@ -320,7 +323,7 @@ ImuseDigiSndMgr::SoundDesc *ImuseDigiSndMgr::allocSlot() {
 bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 
-	sound->bundle = new BundleMgr(_cacheBundleDir);
+	sound->bundle = new BundleMgr(_cacheBundleDir, _cacheBundleBlocks);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
@@ -355,7 +358,7 @@ bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 bool ImuseDigiSndMgr::openVoiceBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 
-	sound->bundle = new BundleMgr(_cacheBundleDir);
+	sound->bundle = new BundleMgr(_cacheBundleDir, _cacheBundleBlocks);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
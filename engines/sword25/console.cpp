@@ -20,16 +20,137 @@
  *
  */
 
+#include "common/algorithm.h"
+
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/script/luascript.h"
+#include "sword25/util/lua/lua.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	DCmd_Register("lua_profile",	WRAP_METHOD(Sword25Console, Cmd_LuaProfile));
+	DCmd_Register("lua_gc",	WRAP_METHOD(Sword25Console, Cmd_LuaGC));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+namespace {
+struct OpcodeCount {
+	const char *name;
+	size_t count;
+
+	bool operator<(const OpcodeCount &other) const {
+		return count > other.count;
+	}
+};
+}
+
+bool Sword25Console::Cmd_LuaProfile(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+
+	if (argc > 2) {
+		DebugPrintf("Usage: %s [on | off]\n", argv[0]);
+		DebugPrintf("Enables or disables Lua profiling, or shows the statistics collected so far\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		script->setProfiling(strcmp(argv[1], "on") == 0);
+		DebugPrintf("Lua profiling is %s\n", script->isProfiling() ? "on" : "off");
+		return true;
+	}
+
+	if (!script->isProfiling()) {
+		DebugPrintf("Lua profiling is off, use '%s on' to enable it\n", argv[0]);
+		return true;
+	}
+
+	const LuaScriptEngine::Profile &profile = script->getProfile();
+	if (profile.frames == 0) {
+		DebugPrintf("No frames have been rendered since profiling was enabled\n");
+		return true;
+	}
+
+	DebugPrintf("%d frames\n", profile.frames);
+	DebugPrintf("Instructions per frame: %d on average, %d at most, %d last\n",
+		(int)(profile.totalInstructions / profile.frames), profile.maxInstructions, profile.lastInstructions);
+	DebugPrintf("Milliseconds per frame outside of rendering: %d on average, %d at most, %d last\n",
+		profile.totalTime / profile.frames, profile.maxTime, profile.lastTime);
+
+	// Show the most executed instructions
+	lua_State *L = static_cast<lua_State *>(script->getScriptObject());
+	Common::Array<OpcodeCount> counts;
+	double total = 0;
+	OpcodeCount opcode;
+	for (int op = 0; (opcode.name = lua_getopcount(L, op, &opcode.count)) != 0; ++op) {
+		counts.push_back(opcode);
+		total += opcode.count;
+	}
+	Common::sort(counts.begin(), counts.end());
+
+	for (uint i = 0; i < MIN<uint>(counts.size(), 10); ++i) {
+		if (counts[i].count == 0)
+			break;
+		DebugPrintf("  %-10s %10.0f  %5.1f%%\n", counts[i].name, (double)counts[i].count, counts[i].count * 100.0 / total);
+	}
+
+	return true;
+}
+
+bool Sword25Console::Cmd_LuaGC(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+	lua_State *L = static_cast<lua_State *>(script->getScriptObject());
+
+	if (argc >= 3 && !strcmp(argv[1], "budget")) {
+		script->setGCBudget(atoi(argv[2]), argc > 3 ? atoi(argv[3]) : script->getGCStartPercent());
+		return true;
+	} else if (argc == 3 && !strcmp(argv[1], "pause")) {
+		DebugPrintf("Pause changed from %d%% to %d%%\n", lua_gc(L, LUA_GCSETPAUSE, atoi(argv[2])), atoi(argv[2]));
+		return true;
+	} else if (argc == 3 && !strcmp(argv[1], "stepmul")) {
+		DebugPrintf("Step multiplier changed from %d%% to %d%%\n", lua_gc(L, LUA_GCSETSTEPMUL, atoi(argv[2])), atoi(argv[2]));
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		script->resetFrameStats();
+		return true;
+	} else if (argc != 1) {
+		DebugPrintf("Usage: %s [budget <ms> [<start percent>] | pause <percent> | stepmul <percent> | reset]\n", argv[0]);
+		DebugPrintf("Shows the garbage collector and frame time statistics, or sets the time spent\n");
+		DebugPrintf("collecting garbage per frame (0 for automatic collection) and the collector parameters\n");
+		return true;
+	}
+
+	const LuaScriptEngine::FrameStats &stats = script->getFrameStats();
+
+	if (script->getGCBudget() > 0)
+		DebugPrintf("Collecting garbage for %d ms per frame, starting at %d%% of the heap size\n", script->getGCBudget(), script->getGCStartPercent());
+	else
+		DebugPrintf("Collecting garbage automatically\n");
+
+	DebugPrintf("Heap size: %d KB, %d KB at most\n", stats.heapSize, stats.maxHeapSize);
+	if (stats.frames == 0)
+		return true;
+
+	DebugPrintf("%d frames, %d collection cycles within the budget\n", stats.frames, stats.gcCycles);
+	DebugPrintf("Milliseconds per frame collecting garbage: %d on average, %d at most, %d last\n",
+		stats.totalGCTime / stats.frames, stats.maxGCTime, stats.lastGCTime);
+
+	DebugPrintf("Frame times:\n");
+	for (int i = 0; i < LuaScriptEngine::FrameStats::kHistogramSize; ++i) {
+		int from = i * LuaScriptEngine::FrameStats::kHistogramStep;
+		if (i < LuaScriptEngine::FrameStats::kHistogramSize - 1)
+			DebugPrintf("  %3d - %3d ms: %d\n", from, from + LuaScriptEngine::FrameStats::kHistogramStep - 1, stats.frameTimes[i]);
+		else
+			DebugPrintf("  %3d ms and more: %d\n", from, stats.frameTimes[i]);
+	}
+
+	return true;
+}
+
 } // End of namespace Sword25
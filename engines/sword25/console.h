@@ -36,6 +36,9 @@ public:
 
 private:
 	Sword25Engine *_vm;
+
+	bool Cmd_LuaProfile(int argc, const char **argv);
+	bool Cmd_LuaGC(int argc, const char **argv);
 };
 
 } // End of namespace Sword25
@@ -251,8 +251,11 @@ static int startFrame(lua_State *L) {
 
 static int endFrame(lua_State *L) {
 	GraphicEngine *pGE = getGE();
+	ScriptEngine *pSE = Kernel::getInstance()->getScript();
 
+	pSE->frameRendering();
 	lua_pushbooleancpp(L, pGE->endFrame());
+	pSE->frameRendered();
 
 	return 1;
 }
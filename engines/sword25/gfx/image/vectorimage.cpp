@@ -215,7 +215,7 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _renderedWidth(0), _renderedHeight(0), _fname(fname) {
 	success = false;
 
 	// Create bitstream object
@@ -605,21 +605,21 @@ bool VectorImage::blit(int posX, int posY,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
+	if (width == -1)
+		width = getWidth();
+	if (height == -1)
+		height = getHeight();
+
 	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
+	if (!_pixelData || _renderedWidth != width || _renderedHeight != height) {
 		render(width, height);
 
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
+		_renderedWidth = width;
+		_renderedHeight = height;
 	}
 
 	RenderedImage *rend = new RenderedImage();
@@ -225,7 +225,12 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
+	// The last rendering of the image, which is reused as long as it is
+	// blitted at the same size. Color modulation is applied when blitting,
+	// so it does not require the image to be rendered again.
 	byte *_pixelData;
+	int _renderedWidth;
+	int _renderedHeight;
 
 	Common::String _fname;
 };
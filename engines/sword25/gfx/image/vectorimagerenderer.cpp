@@ -60,29 +60,20 @@ void art_rgb_fill_run1(byte *buf, byte r, byte g, byte b, int n) {
 }
 
 void art_rgb_run_alpha1(byte *buf, byte r, byte g, byte b, int alpha, int n) {
-	int i;
-	int v;
-
-	for (i = 0; i < n; i++) {
-#if defined(SCUMM_LITTLE_ENDIAN)
-		v = *buf;
-		*buf++ = v + (((b - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((g - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((r - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = MIN(v + alpha, 0xff);
-#else
-		v = *buf;
-		*buf++ = MIN(v + alpha, 0xff);
-		v = *buf;
-		*buf++ = v + (((r - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((g - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((b - v) * alpha + 0x80) >> 8);
-#endif
+	// Blending v + (((c - v) * alpha + 0x80) >> 8) is the same as blending
+	// (v * (256 - alpha) + c * alpha + 0x80) >> 8, which never exceeds 16 bits.
+	// This allows red and blue to be blended together in one multiplication.
+	uint32 *pixel = (uint32 *)buf;
+	const uint32 inverse = 256 - alpha;
+	const uint32 rb = (((uint32)r << 16) | b) * alpha + 0x00800080;
+	const uint32 gg = (uint32)g * alpha + 0x80;
+
+	for (int i = 0; i < n; i++) {
+		uint32 v = *pixel;
+		uint32 vrb = (((v & 0x00ff00ff) * inverse + rb) >> 8) & 0x00ff00ff;
+		uint32 vg = (((v >> 8) & 0xff) * inverse + gg) & 0xff00;
+		uint32 va = MIN<uint32>((v >> 24) + alpha, 0xff) << 24;
+		*pixel++ = va | vrb | vg;
 	}
 }
 
@@ -245,14 +236,26 @@ void art_rgb_svp_alpha1(const ArtSVP *svp,
 		a += da;
 	}
 
-	data.buf = buf;
+	// Rows outside the vertical extent of the shape are not covered, so
+	// only the rows between its topmost and bottommost segment are rendered
+	int top = y1, bottom = y0;
+	for (i = 0; i < svp->n_segs; i++) {
+		top = MIN(top, (int)floor(svp->segs[i].bbox.y0));
+		bottom = MAX(bottom, (int)ceil(svp->segs[i].bbox.y1));
+	}
+	top = MAX(top, y0);
+	bottom = MIN(bottom, y1);
+	if (top >= bottom)
+		return;
+
+	data.buf = buf + (top - y0) * rowstride;
 	data.rowstride = rowstride;
 	data.x0 = x0;
 	data.x1 = x1;
 	if (alpha == 255)
-		art_svp_render_aa(svp, x0, y0, x1, y1, art_rgb_svp_alpha_opaque_callback1, &data);
+		art_svp_render_aa(svp, x0, top, x1, bottom, art_rgb_svp_alpha_opaque_callback1, &data);
 	else
-		art_svp_render_aa(svp, x0, y0, x1, y1, art_rgb_svp_alpha_callback1, &data);
+		art_svp_render_aa(svp, x0, top, x1, bottom, art_rgb_svp_alpha_callback1, &data);
 }
 
 static int art_vpath_len(ArtVpath *a) {
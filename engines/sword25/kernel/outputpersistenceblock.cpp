@@ -85,6 +85,19 @@ void OutputPersistenceBlock::writeByteArray(Common::Array<byte> &value) {
 	rawWrite(&value[0], value.size());
 }
 
+uint OutputPersistenceBlock::beginByteArray() {
+	writeMarker(BLOCK_MARKER);
+
+	// The size is written as a placeholder, and filled in by endByteArray()
+	write((uint)0);
+	return _data.size() - sizeof(uint);
+}
+
+void OutputPersistenceBlock::endByteArray(uint sizePosition) {
+	uint size = TO_LE_32(_data.size() - sizePosition - sizeof(uint));
+	memcpy(&_data[sizePosition], &size, sizeof(size));
+}
+
 void OutputPersistenceBlock::writeMarker(byte marker) {
 	_data.push_back(marker);
 }
@@ -92,6 +105,14 @@ void OutputPersistenceBlock::writeMarker(byte marker) {
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
 	if (size > 0) {
 		uint oldSize = _data.size();
+
+		// Grow the buffer in powers of two. Array::resize() only allocates as much as is
+		// needed, which makes many small writes copy the whole buffer each time.
+		uint capacity = INITIAL_BUFFER_SIZE;
+		while (capacity < oldSize + size)
+			capacity <<= 1;
+		_data.reserve(capacity);
+
 		_data.resize(oldSize + size);
 		memcpy(&_data[oldSize], dataPtr, size);
 	}
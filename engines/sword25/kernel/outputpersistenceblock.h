@@ -48,6 +48,18 @@ public:
 	void writeString(const Common::String &string);
 	void writeByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Writes a byte array whose size is not known in advance, e.g. data which is
+	 * streamed into the block while it is being generated.
+	 * The data is appended with appendByteArray(), and endByteArray() completes the array.
+	 * @return              The position of the array size, which is passed to endByteArray()
+	 */
+	uint beginByteArray();
+	void appendByteArray(const void *dataPtr, size_t size) {
+		rawWrite(dataPtr, size);
+	}
+	void endByteArray(uint sizePosition);
+
 	const void *getData() const {
 		return &_data[0];
 	}
@@ -30,6 +30,7 @@
  */
 
 #include "common/fs.h"
+#include "common/mutex.h"
 #include "common/savefile.h"
 #include "common/zlib.h"
 #include "sword25/kernel/kernel.h"
@@ -123,10 +124,45 @@ struct SavegameInformation {
 struct PersistenceService::Impl {
 	SavegameInformation _savegameInformations[SLOT_COUNT];
 
+	// Slots whose write failed. They may be reported from another thread
+	// and are re-read from disk on the next access.
+	Common::Mutex _failedSlotsMutex;
+	Common::Array<uint> _failedSlots;
+
 	Impl() {
 		reloadSlots();
 	}
 
+	SavegameInformation &getSlotInformation(uint slotID) {
+		Common::Array<uint> failedSlots;
+
+		{
+			Common::StackLock lock(_failedSlotsMutex);
+			failedSlots = _failedSlots;
+			_failedSlots.clear();
+		}
+
+		for (uint i = 0; i < failedSlots.size(); ++i)
+			readSlotSavegameInformation(failedSlots[i]);
+
+		return _savegameInformations[slotID];
+	}
+
+	static void saveCompleted(const Common::String &filename, bool success, void *refCon) {
+		if (success)
+			return;
+
+		warning("Writing the savegame \"%s\" failed", filename.c_str());
+
+		Impl *impl = (Impl *)refCon;
+		for (uint slotID = 0; slotID < SLOT_COUNT; ++slotID) {
+			if (generateSavegameFilename(slotID) == filename) {
+				Common::StackLock lock(impl->_failedSlotsMutex);
+				impl->_failedSlots.push_back(slotID);
+			}
+		}
+	}
+
 	void reloadSlots() {
 		// Iterate through all the saved games, and read their thumbnails.
 		for (uint i = 0; i < SLOT_COUNT; ++i) {
@@ -227,20 +263,20 @@ bool checkslotID(uint slotID) {
 bool PersistenceService::isSlotOccupied(uint slotID) {
 	if (!checkslotID(slotID))
 		return false;
-	return _impl->_savegameInformations[slotID].isOccupied;
+	return _impl->getSlotInformation(slotID).isOccupied;
 }
 
 bool PersistenceService::isSavegameCompatible(uint slotID) {
 	if (!checkslotID(slotID))
 		return false;
-	return _impl->_savegameInformations[slotID].isCompatible;
+	return _impl->getSlotInformation(slotID).isCompatible;
 }
 
 Common::String &PersistenceService::getSavegameDescription(uint slotID) {
 	static Common::String emptyString;
 	if (!checkslotID(slotID))
 		return emptyString;
-	return _impl->_savegameInformations[slotID].description;
+	return _impl->getSlotInformation(slotID).description;
 }
 
 Common::String &PersistenceService::getSavegameFilename(uint slotID) {
@@ -254,7 +290,7 @@ Common::String &PersistenceService::getSavegameFilename(uint slotID) {
 int PersistenceService::getSavegameVersion(uint slotID) {
 	if (!checkslotID(slotID))
 		return -1;
-	return _impl->_savegameInformations[slotID].version;
+	return _impl->getSlotInformation(slotID).version;
 }
 
 bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotFilename) {
@@ -271,8 +307,10 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	Common::String filename = generateSavegameFilename(slotID);
 
 	// Spielstanddatei ffnen und die Headerdaten schreiben.
+	// The savefile manager may compress and write the file in the background.
+	// A failure is reported to saveCompleted(), which has the slot re-read.
 	Common::SaveFileManager *sfm = g_system->getSavefileManager();
-	Common::OutSaveFile *file = sfm->openForSaving(filename);
+	Common::OutSaveFile *file = sfm->openForSavingAsync(filename, Impl::saveCompleted, _impl);
 
 	file->writeString(FILE_MARKER);
 	file->writeByte(0);
@@ -286,7 +324,8 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 
 	TimeDate dt;
 	g_system->getTimeAndDate(dt);
-	file->writeString(formatTimestamp(dt));
+	Common::String timestamp = formatTimestamp(dt);
+	file->writeString(timestamp);
 	file->writeByte(0);
 
 	if (file->err()) {
@@ -294,6 +333,8 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	}
 
 	// Alle notwendigen Module persistieren.
+	// The scripts are frozen while this happens, so the time is reported separately from writing the file.
+	uint32 persistStartTime = g_system->getMillis();
 	OutputPersistenceBlock writer;
 	bool success = true;
 	success &= Kernel::getInstance()->getScript()->persist(writer);
@@ -304,6 +345,8 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	if (!success) {
 		error("Unable to persist modules for savegame file \"%s\".", filename.c_str());
 	}
+	uint32 persistTime = g_system->getMillis() - persistStartTime;
+	uint32 writeStartTime = g_system->getMillis();
 
 	// Write the save game data uncompressed, since the final saved game will be
 	// compressed anyway.
@@ -316,6 +359,18 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	file->writeByte(0);
 	file->write(writer.getData(), writer.getDataSize());
 
+	// The savegame is not on disk yet, so the slot information is taken
+	// from the header just written instead of being read back
+	SavegameInformation &curSavegameInfo = _impl->getSlotInformation(slotID);
+	curSavegameInfo.clear();
+	curSavegameInfo.isOccupied = true;
+	curSavegameInfo.isCompatible = true;
+	curSavegameInfo.version = VERSIONNUM;
+	curSavegameInfo.description = timestamp;
+	curSavegameInfo.gamedataLength = writer.getDataSize();
+	curSavegameInfo.gamedataUncompressedLength = writer.getDataSize();
+	curSavegameInfo.gamedataOffset = strlen(FILE_MARKER) + strlen(VERSIONID) + strlen(buf) + timestamp.size() + 2 * strlen(sBuffer) + 6;
+
 	// Get the screenshot
 	Common::SeekableReadStream *thumbnail = Kernel::getInstance()->getGfx()->getThumbnail();
 
@@ -335,8 +390,8 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	file->finalize();
 	delete file;
 
-	// Savegameinformationen fr diesen Slot aktualisieren.
-	_impl->readSlotSavegameInformation(slotID);
+	debug(1, "Saved %u bytes to \"%s\": persisting took %d ms, handing over the data %d ms",
+	      writer.getDataSize(), filename.c_str(), persistTime, g_system->getMillis() - writeStartTime);
 
 	// Empty the cache, to remove old thumbnails
 	Kernel::getInstance()->getResourceManager()->emptyThumbnailCache();
@@ -355,7 +410,7 @@ bool PersistenceService::loadGame(uint slotID) {
 		return false;
 	}
 
-	SavegameInformation &curSavegameInfo = _impl->_savegameInformations[slotID];
+	SavegameInformation &curSavegameInfo = _impl->getSlotInformation(slotID);
 
 	// berprfen, ob der Slot belegt ist.
 	if (!curSavegameInfo.isOccupied) {
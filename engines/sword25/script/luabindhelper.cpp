@@ -37,6 +37,9 @@ namespace {
 const char *METATABLES_TABLE_NAME = "__METATABLES";
 const char *PERMANENTS_TABLE_NAME = "Permanents";
 
+// The address of this variable is the registry key of the table of cached values
+const char CACHE_TABLE_KEY = 0;
+
 bool registerPermanent(lua_State *L, const Common::String &name) {
 	// A C function has to be on the stack
 	if (!lua_iscfunction(L, -1))
@@ -308,7 +311,15 @@ void *LuaBindhelper::my_checkudata(lua_State *L, int ud, const char *tname) {
 	if (p != NULL) { /* value is a userdata? */
 		if (lua_getmetatable(L, ud)) { /* does it have a metatable? */
 			// lua_getfield(L, LUA_REGISTRYINDEX, tname);  /* get correct metatable */
-			LuaBindhelper::getMetatable(L, tname);
+			// This is called for every method call, so the metatable is only looked up by
+			// its name the first time
+			getCachedValue(L, tname);
+			if (lua_isnil(L, -1)) {
+				lua_pop(L, 1);
+				LuaBindhelper::getMetatable(L, tname);
+				lua_pushvalue(L, -1);
+				setCachedValue(L, tname);
+			}
 			if (lua_rawequal(L, -1, -2)) { /* does it have the correct mt? */
 				lua_settop(L, top);
 				return p;
@@ -321,6 +332,45 @@ void *LuaBindhelper::my_checkudata(lua_State *L, int ud, const char *tname) {
 }
 
 
+void LuaBindhelper::getCachedValue(lua_State *L, const void *key) {
+	lua_pushlightuserdata(L, const_cast<char *>(&CACHE_TABLE_KEY));
+	lua_rawget(L, LUA_REGISTRYINDEX);
+
+	// Without a cache table, the nil is left on the stack as the result
+	if (!lua_isnil(L, -1)) {
+		lua_pushlightuserdata(L, const_cast<void *>(key));
+		lua_rawget(L, -2);
+		lua_remove(L, -2);
+	}
+}
+
+void LuaBindhelper::setCachedValue(lua_State *L, const void *key) {
+	lua_pushlightuserdata(L, const_cast<char *>(&CACHE_TABLE_KEY));
+	lua_rawget(L, LUA_REGISTRYINDEX);
+
+	// Create the cache table, if it doesn't yet exist
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushlightuserdata(L, const_cast<char *>(&CACHE_TABLE_KEY));
+		lua_pushvalue(L, -2);
+		lua_rawset(L, LUA_REGISTRYINDEX);
+	}
+
+	lua_pushlightuserdata(L, const_cast<void *>(key));
+	lua_pushvalue(L, -3);
+	lua_rawset(L, -3);
+
+	// Pop the cache table and the value from the stack
+	lua_pop(L, 2);
+}
+
+void LuaBindhelper::clearCache(lua_State *L) {
+	lua_pushlightuserdata(L, const_cast<char *>(&CACHE_TABLE_KEY));
+	lua_pushnil(L);
+	lua_rawset(L, LUA_REGISTRYINDEX);
+}
+
 bool LuaBindhelper::createTable(lua_State *L, const Common::String &tableName) {
 	const char *partBegin = tableName.c_str();
 
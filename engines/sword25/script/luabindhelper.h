@@ -107,8 +107,37 @@ public:
 
 	static bool getMetatable(lua_State *L, const Common::String &tableName);
 
+	/**
+	 * Returns the userdata at the given index if it belongs to the given class, otherwise NULL.
+	 * @param L             A pointer to the Lua VM
+	 * @param ud            The stack index of the userdata
+	 * @param tname         The class name. This has to be a string constant, since the
+	 * metatable is cached using its address.
+	 */
 	static void *my_checkudata(lua_State *L, int ud, const char *tname);
 
+	/**
+	 * Pushes the value cached for a key onto the Lua stack, or nil if there is none.
+	 * @param L             A pointer to the Lua VM
+	 * @param key           The key, usually the address of a string constant
+	 */
+	static void getCachedValue(lua_State *L, const void *key);
+
+	/**
+	 * Caches the value on top of the Lua stack for a key, and pops it.
+	 * @param L             A pointer to the Lua VM
+	 * @param key           The key, usually the address of a string constant
+	 */
+	static void setCachedValue(lua_State *L, const void *key);
+
+	/**
+	 * Empties the cache of looked up values.
+	 * @param L             A pointer to the Lua VM
+	 * @remark              This has to be called whenever the cached tables are replaced,
+	 * as is the case when a savegame is loaded.
+	 */
+	static void clearCache(lua_State *L);
+
 private:
 	static bool createTable(lua_State *L, const Common::String &tableName);
 };
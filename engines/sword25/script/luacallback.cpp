@@ -44,7 +44,11 @@ namespace Sword25 {
 LuaCallback::LuaCallback(lua_State *L) {
 	// Create callback table
 	lua_newtable(L);
+	lua_pushvalue(L, -1);
 	lua_setglobal(L, CALLBACKTABLE_NAME);
+
+	// The new table replaces the one found by earlier lookups
+	LuaBindhelper::setCachedValue(L, CALLBACKTABLE_NAME);
 }
 
 LuaCallback::~LuaCallback() {
@@ -129,6 +133,9 @@ void LuaCallback::invokeCallbackFunctions(lua_State *L, uint objectHandle) {
 			lua_pop(L, 1);
 		}
 	}
+
+	// Pop the object callback table from the stack
+	lua_pop(L, 1);
 }
 
 void LuaCallback::ensureObjectCallbackTableExists(lua_State *L, uint objectHandle) {
@@ -153,7 +160,15 @@ void LuaCallback::ensureObjectCallbackTableExists(lua_State *L, uint objectHandl
 }
 
 void LuaCallback::pushCallbackTable(lua_State *L) {
-	lua_getglobal(L, CALLBACKTABLE_NAME);
+	// Callbacks are invoked for every input event and animation action, so the
+	// callback table is only looked up by its name once
+	LuaBindhelper::getCachedValue(L, CALLBACKTABLE_NAME);
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		lua_getglobal(L, CALLBACKTABLE_NAME);
+		lua_pushvalue(L, -1);
+		LuaBindhelper::setCachedValue(L, CALLBACKTABLE_NAME);
+	}
 }
 
 void LuaCallback::pushObjectCallbackTable(lua_State *L, uint objectHandle) {
@@ -31,6 +31,7 @@
 
 #include "common/array.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sword25/sword25.h"
 #include "sword25/package/packagemanager.h"
@@ -50,7 +51,16 @@ namespace Sword25 {
 LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 	ScriptEngine(KernelPtr),
 	_state(0),
-	_pcallErrorhandlerRegistryIndex(0) {
+	_pcallErrorhandlerRegistryIndex(0),
+	_frameStartTime(0),
+	_frameStartInstructions(0),
+	_gcBudget(0),
+	_gcStartPercent(150),
+	_gcStartSize(0),
+	_gcCycleRunning(false),
+	_lastFrameTime(0) {
+	memset(&_profile, 0, sizeof(_profile));
+	memset(&_frameStats, 0, sizeof(_frameStats));
 }
 
 LuaScriptEngine::~LuaScriptEngine() {
@@ -135,6 +145,118 @@ bool LuaScriptEngine::init() {
 	return true;
 }
 
+namespace {
+double countInstructions(lua_State *L) {
+	double total = 0;
+	size_t count;
+	for (int op = 0; lua_getopcount(L, op, &count); ++op)
+		total += count;
+
+	return total;
+}
+}
+
+void LuaScriptEngine::setProfiling(bool enable) {
+	lua_setprofiling(_state, enable);
+
+	memset(&_profile, 0, sizeof(_profile));
+	_frameStartTime = g_system->getMillis();
+	_frameStartInstructions = 0;
+}
+
+bool LuaScriptEngine::isProfiling() const {
+	return lua_getprofiling(_state) != 0;
+}
+
+void LuaScriptEngine::frameRendering() {
+	if (isProfiling())
+		updateProfile();
+
+	updateFrameStats();
+	collectGarbage();
+}
+
+void LuaScriptEngine::updateProfile() {
+	double instructions = countInstructions(_state);
+	uint32 frameInstructions = (uint32)(instructions - _frameStartInstructions);
+	uint32 frameTime = g_system->getMillis() - _frameStartTime;
+
+	_profile.frames++;
+	_profile.lastInstructions = frameInstructions;
+	_profile.maxInstructions = MAX(_profile.maxInstructions, frameInstructions);
+	_profile.totalInstructions += frameInstructions;
+	_profile.lastTime = frameTime;
+	_profile.maxTime = MAX(_profile.maxTime, frameTime);
+	_profile.totalTime += frameTime;
+
+	// Instructions executed while rendering, e.g. by callbacks, count towards the next frame
+	_frameStartInstructions = instructions;
+}
+
+void LuaScriptEngine::frameRendered() {
+	if (isProfiling())
+		_frameStartTime = g_system->getMillis();
+}
+
+void LuaScriptEngine::setGCBudget(uint32 budget, uint32 startPercent) {
+	_gcBudget = budget;
+	_gcStartPercent = startPercent;
+	_gcStartSize = lua_gc(_state, LUA_GCCOUNT, 0) * _gcStartPercent / 100;
+	_gcCycleRunning = false;
+}
+
+void LuaScriptEngine::collectGarbage() {
+	// Amount of work done by each incremental step, in KB of allocations
+	const int GC_STEP_SIZE = 4;
+
+	uint32 heapSize = lua_gc(_state, LUA_GCCOUNT, 0);
+
+	if (_gcBudget > 0 && (_gcCycleRunning || heapSize >= _gcStartSize)) {
+		uint32 startTime = g_system->getMillis();
+		uint32 time;
+
+		_gcCycleRunning = true;
+		do {
+			if (lua_gc(_state, LUA_GCSTEP, GC_STEP_SIZE)) {
+				_gcCycleRunning = false;
+				_gcStartSize = lua_gc(_state, LUA_GCCOUNT, 0) * _gcStartPercent / 100;
+				_frameStats.gcCycles++;
+				break;
+			}
+			time = g_system->getMillis() - startTime;
+		} while (time < _gcBudget);
+
+		time = g_system->getMillis() - startTime;
+		_frameStats.lastGCTime = time;
+		_frameStats.maxGCTime = MAX(_frameStats.maxGCTime, time);
+		_frameStats.totalGCTime += time;
+
+		heapSize = lua_gc(_state, LUA_GCCOUNT, 0);
+	} else {
+		_frameStats.lastGCTime = 0;
+	}
+
+	_frameStats.heapSize = heapSize;
+	_frameStats.maxHeapSize = MAX(_frameStats.maxHeapSize, heapSize);
+}
+
+void LuaScriptEngine::updateFrameStats() {
+	uint32 now = g_system->getMillis();
+
+	// The first frame has no predecessor to be measured against
+	if (_frameStats.frames > 0) {
+		uint bucket = MIN<uint>((now - _lastFrameTime) / FrameStats::kHistogramStep, FrameStats::kHistogramSize - 1);
+		_frameStats.frameTimes[bucket]++;
+	}
+
+	_frameStats.frames++;
+	_lastFrameTime = now;
+}
+
+void LuaScriptEngine::resetFrameStats() {
+	memset(&_frameStats, 0, sizeof(_frameStats));
+}
+
 bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 #ifdef DEBUG
 	int __startStackDepth = lua_gettop(_state);
@@ -387,11 +509,8 @@ bool pushPermanentsTable(lua_State *L, PERMANENT_TABLE_TYPE tableType) {
 
 namespace {
 int chunkwriter(lua_State *L, const void *p, size_t sz, void *ud) {
-	Common::Array<byte> & chunkData = *reinterpret_cast<Common::Array<byte> * >(ud);
-	const byte *buffer = reinterpret_cast<const byte *>(p);
-
-	while (sz--)
-		chunkData.push_back(*buffer++);
+	OutputPersistenceBlock &writer = *reinterpret_cast<OutputPersistenceBlock *>(ud);
+	writer.appendByteArray(p, sz);
 
 	return 1;
 }
@@ -409,12 +528,10 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a Common::Array
-	Common::Array<byte> chunkData;
-	pluto_persist(_state, chunkwriter, &chunkData);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.writeByteArray(chunkData);
+	// Lua persists the data straight into the writer, as a byte array
+	uint sizePosition = writer.beginByteArray();
+	pluto_persist(_state, chunkwriter, &writer);
+	writer.endByteArray(sizePosition);
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
@@ -490,6 +607,9 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	// beginning of the function, because the global table is emptied below
 	pushPermanentsTable(_state, PTT_UNPERSIST);
 
+	// The cached lookups refer to tables which are about to be replaced
+	LuaBindhelper::clearCache(_state);
+
 	// All items from global table of _G and __METATABLES are removed.
 	// After a garbage collection is performed, and thus all managed objects deleted
 
@@ -543,9 +663,16 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	// The table with the loaded data is popped from the stack
 	lua_pop(_state, 1);
 
+	// Finalisers run while clearing the global table may have cached the old tables again
+	LuaBindhelper::clearCache(_state);
+
 	// Force garbage collection
 	lua_gc(_state, LUA_GCCOLLECT, 0);
 
+	// The collection cycle in progress was finished by the full collection
+	_gcStartSize = lua_gc(_state, LUA_GCCOUNT, 0) * _gcStartPercent / 100;
+	_gcCycleRunning = false;
+
 	return true;
 }
 
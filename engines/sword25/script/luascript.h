@@ -45,6 +45,38 @@ class Kernel;
 
 class LuaScriptEngine : public ScriptEngine {
 public:
+	/**
+	 * Script execution statistics, collected while profiling is enabled
+	 */
+	struct Profile {
+		uint32 frames;              ///< Number of frames rendered
+		uint32 lastInstructions;    ///< VM instructions executed for the last frame
+		uint32 maxInstructions;     ///< Most VM instructions executed for a frame
+		double totalInstructions;   ///< VM instructions executed for all frames
+		uint32 lastTime;            ///< Milliseconds spent outside of rendering for the last frame
+		uint32 maxTime;             ///< Most milliseconds spent outside of rendering for a frame
+		uint32 totalTime;           ///< Milliseconds spent outside of rendering for all frames
+	};
+
+	/**
+	 * Garbage collector and frame time statistics, collected for every frame
+	 */
+	struct FrameStats {
+		enum {
+			kHistogramStep = 10,        ///< Milliseconds covered by each bucket of the frame time histogram
+			kHistogramSize = 11         ///< Number of buckets, the last one holds all longer frames
+		};
+
+		uint32 frames;              ///< Number of frames rendered
+		uint32 gcCycles;            ///< Garbage collection cycles completed within the frame budget
+		uint32 lastGCTime;          ///< Milliseconds spent collecting garbage for the last frame
+		uint32 maxGCTime;           ///< Most milliseconds spent collecting garbage for a frame
+		uint32 totalGCTime;         ///< Milliseconds spent collecting garbage for all frames
+		uint32 heapSize;            ///< Size of the Lua heap in KB at the end of the last frame
+		uint32 maxHeapSize;         ///< Largest size of the Lua heap in KB at the end of a frame
+		uint32 frameTimes[kHistogramSize]; ///< Histogram of the time between two frames
+	};
+
 	LuaScriptEngine(Kernel *KernelPtr);
 	virtual ~LuaScriptEngine();
 
@@ -93,10 +125,66 @@ public:
 	 */
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
+	virtual void frameRendering();
+	virtual void frameRendered();
+
+	/**
+	 * Enables or disables counting of the executed VM instructions, and the per frame statistics.
+	 * @remark              Enabling the profiling resets all statistics.
+	 */
+	void setProfiling(bool enable);
+	bool isProfiling() const;
+
+	/**
+	 * Returns the per frame statistics collected since profiling was enabled.
+	 */
+	const Profile &getProfile() const {
+		return _profile;
+	}
+
+	/**
+	 * Sets the time which is spent collecting garbage before each frame is rendered.
+	 * @param budget        Milliseconds per frame. 0 leaves the collection to the automatic
+	 *                      collector of Lua, which runs while scripts allocate memory.
+	 * @param startPercent  A new collection cycle is started once the heap has grown to this
+	 *                      percentage of its size after the last cycle.
+	 * @remark              The automatic collector stays enabled as a backstop. Its pause should
+	 *                      be larger than startPercent, so that it only runs if the budget does
+	 *                      not keep up with the allocations of the scripts.
+	 */
+	void setGCBudget(uint32 budget, uint32 startPercent);
+	uint32 getGCBudget() const {
+		return _gcBudget;
+	}
+	uint32 getGCStartPercent() const {
+		return _gcStartPercent;
+	}
+
+	const FrameStats &getFrameStats() const {
+		return _frameStats;
+	}
+	void resetFrameStats();
+
 private:
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
 
+	Profile _profile;
+	uint32 _frameStartTime;
+	double _frameStartInstructions;
+
+	uint32 _gcBudget;
+	uint32 _gcStartPercent;
+	uint32 _gcStartSize;
+	bool _gcCycleRunning;
+
+	FrameStats _frameStats;
+	uint32 _lastFrameTime;
+
+	void updateProfile();
+	void collectGarbage();
+	void updateFrameStats();
+
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
 	bool executeBuffer(const byte *data, uint size, const Common::String &name) const;
@@ -86,6 +86,13 @@ public:
 
 	virtual bool persist(OutputPersistenceBlock &writer) = 0;
 	virtual bool unpersist(InputPersistenceBlock &reader) = 0;
+
+	/**
+	 * Called by the graphics engine before and after a frame is rendered, which allows
+	 * the script engine to measure how much work the scripts do per frame.
+	 */
+	virtual void frameRendering() {}
+	virtual void frameRendered() {}
 };
 
 } // End of namespace Sword25
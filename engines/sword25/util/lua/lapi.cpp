@@ -945,6 +945,41 @@ LUA_API int lua_gc (lua_State *L, int what, int data) {
 }
 
 
+/*
+** Instruction profiling. Enabling the profiler clears the counts.
+*/
+
+LUA_API void lua_setprofiling (lua_State *L, int enable) {
+  global_State *g;
+  int i;
+  lua_lock(L);
+  g = G(L);
+  if (enable && !g->profiling) {
+    for (i=0; i<NUM_OPCODES; i++) g->opcount[i] = 0;
+  }
+  g->profiling = cast_byte(enable != 0);
+  lua_unlock(L);
+}
+
+
+LUA_API int lua_getprofiling (lua_State *L) {
+  return G(L)->profiling;
+}
+
+
+/*
+** Returns the name of opcode `op' and stores the number of times it was
+** executed in `count'. Returns NULL if there is no such opcode.
+*/
+LUA_API const char *lua_getopcount (lua_State *L, int op, size_t *count) {
+  if (op < 0 || op >= NUM_OPCODES)
+    return NULL;
+  if (count)
+    *count = G(L)->opcount[op];
+  return luaP_opnames[op];
+}
+
+
 
 /*
 ** miscellaneous functions
@@ -10,6 +10,7 @@
 #include "lua.h"
 
 #include "lobject.h"
+#include "lopcodes.h"
 #include "ltm.h"
 #include "lzio.h"
 
@@ -91,6 +92,8 @@ typedef struct global_State {
   UpVal uvhead;  /* head of double-linked list of all open upvalues */
   struct Table *mt[NUM_TAGS];  /* metatables for basic types */
   TString *tmname[TM_N];  /* array with tag-method names */
+  lu_byte profiling;  /* count executed instructions? */
+  lu_mem opcount[NUM_OPCODES];  /* executed instructions per opcode */
 } global_State;
 
 
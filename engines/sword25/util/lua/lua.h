@@ -231,6 +231,15 @@ LUA_API int  (lua_status) (lua_State *L);
 LUA_API int (lua_gc) (lua_State *L, int what, int data);
 
 
+/*
+** instruction profiling
+*/
+
+LUA_API void (lua_setprofiling) (lua_State *L, int enable);
+LUA_API int (lua_getprofiling) (lua_State *L);
+LUA_API const char *(lua_getopcount) (lua_State *L, int op, size_t *count);
+
+
 /*
 ** miscellaneous functions
 */
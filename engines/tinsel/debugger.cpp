@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/coroutines.h"
+
 #include "tinsel/tinsel.h"
 #include "tinsel/debugger.h"
 #include "tinsel/dialogs.h"
@@ -28,6 +30,7 @@
 #include "tinsel/sound.h"
 #include "tinsel/music.h"
 #include "tinsel/font.h"
+#include "tinsel/heapmem.h"
 #include "tinsel/strres.h"
 
 namespace Tinsel {
@@ -67,6 +70,8 @@ Console::Console() : GUI::Debugger() {
 	DCmd_Register("music",		WRAP_METHOD(Console, cmd_music));
 	DCmd_Register("sound",		WRAP_METHOD(Console, cmd_sound));
 	DCmd_Register("string",		WRAP_METHOD(Console, cmd_string));
+	DCmd_Register("heap",		WRAP_METHOD(Console, cmd_heap));
+	DCmd_Register("coroutines",	WRAP_METHOD(Console, cmd_coroutines));
 }
 
 Console::~Console() {
@@ -161,4 +166,43 @@ bool Console::cmd_string(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmd_heap(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("%s [size_in_kb]\n", argv[0]);
+		DebugPrintf("Shows the memory heap usage, and optionally changes the heap size\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		int size = strToInt(argv[1]);
+		if (size <= 0) {
+			DebugPrintf("Heap size must be positive!\n");
+			return true;
+		}
+		MemorySetHeapSize(size * 1024);
+	}
+
+	MEM_STATS stats;
+	MemoryGetStats(&stats);
+
+	DebugPrintf("Heap: %d KB used of %d KB (peak %d KB, %d KB fixed, %d KB locked)\n",
+		stats.usedSize / 1024, stats.heapSize / 1024, stats.peakSize / 1024,
+		stats.fixedSize / 1024, stats.lockedSize / 1024);
+	DebugPrintf("Nodes: %d, %d loaded, %d locked\n", stats.numNodes, stats.numLoaded, stats.numLocked);
+	DebugPrintf("Blocks: %d allocated, %d discarded, %d failed to fit\n",
+		stats.numAllocs, stats.numDiscards, stats.numFailures);
+
+	return true;
+}
+
+bool Console::cmd_coroutines(int argc, const char **argv) {
+	Common::CoroutineScheduler::Stats stats = CoroScheduler.getStats();
+
+	DebugPrintf("Processes: %d active (peak %d), %d in the pool\n", stats.numProcesses, stats.maxProcesses, stats.poolSize);
+	DebugPrintf("%d sleeping, %d waiting, %d run on the last tick\n", stats.numSleeping, stats.numWaiting, stats.numDispatched);
+	DebugPrintf("%d ticks, %d ms total process time (%d ms at most)\n", stats.numTicks, stats.processTime, stats.maxProcessTime);
+
+	return true;
+}
+
 } // End of namespace Tinsel
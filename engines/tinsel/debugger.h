@@ -40,6 +40,8 @@ private:
 	bool cmd_music(int argc, const char **argv);
 	bool cmd_sound(int argc, const char **argv);
 	bool cmd_string(int argc, const char **argv);
+	bool cmd_heap(int argc, const char **argv);
+	bool cmd_coroutines(int argc, const char **argv);
 };
 
 } // End of namespace Tinsel
@@ -41,6 +41,8 @@ namespace Tinsel {
 struct MEM_NODE {
 	MEM_NODE *pNext;	// link to the next node in the list
 	MEM_NODE *pPrev;	// link to the previous node in the list
+	MEM_NODE *pLruNext;	// link to the next newer discardable node
+	MEM_NODE *pLruPrev;	// link to the next older discardable node
 	uint8 *pBaseAddr;	// base address of the memory object
 	long size;		// size of the memory object
 	uint32 lruTime;		// time when memory object was last accessed
@@ -69,6 +71,13 @@ MEM_NODE g_s_fixedMnodesList[5];
 // the mnode heap sentinel
 static MEM_NODE g_heapSentinel;
 
+// the sentinel of the discardable mnodes, oldest first
+static MEM_NODE g_lruSentinel;
+
+// the total heap size, and the statistics shown by the debugger
+static uint32 g_heapSize;
+static MEM_STATS g_memStats;
+
 //
 static MEM_NODE *AllocMemNode();
 
@@ -125,11 +134,18 @@ void MemoryInit() {
 	// flag sentinel as locked
 	g_heapSentinel.flags = DWM_LOCKED | DWM_SENTINEL;
 
+	// set cyclic links to the LRU sentinel
+	g_lruSentinel.pLruPrev = &g_lruSentinel;
+	g_lruSentinel.pLruNext = &g_lruSentinel;
+
 	// store the current heap size in the sentinel
 	uint32 size = MemoryPoolSize[0];
 	if (TinselVersion == TINSEL_V1) size = MemoryPoolSize[1];
 	else if (TinselVersion == TINSEL_V2) size = MemoryPoolSize[2];
 	g_heapSentinel.size = size;
+	g_heapSize = size;
+
+	memset(&g_memStats, 0, sizeof(g_memStats));
 }
 
 /**
@@ -188,37 +204,55 @@ void FreeMemNode(MEM_NODE *pMemNode) {
 }
 
 
+/**
+ * Removes a mnode from the list of discardable mnodes, if it is on it.
+ * @param pMemNode			Node of the memory object
+ */
+static void LruUnlink(MEM_NODE *pMemNode) {
+	if (pMemNode->pLruNext) {
+		pMemNode->pLruNext->pLruPrev = pMemNode->pLruPrev;
+		pMemNode->pLruPrev->pLruNext = pMemNode->pLruNext;
+		pMemNode->pLruNext = pMemNode->pLruPrev = NULL;
+	}
+}
+
+/**
+ * Adds a mnode to the list of discardable mnodes, keeping the list sorted
+ * by LRU time. The new time is almost always the newest one, so this only
+ * has to step over the few nodes allocated during the current tick.
+ * @param pMemNode			Node of the memory object
+ */
+static void LruLink(MEM_NODE *pMemNode) {
+	MEM_NODE *pPrev = g_lruSentinel.pLruPrev;
+	while (pPrev != &g_lruSentinel && pPrev->lruTime > pMemNode->lruTime)
+		pPrev = pPrev->pLruPrev;
+
+	pMemNode->pLruPrev = pPrev;
+	pMemNode->pLruNext = pPrev->pLruNext;
+	pPrev->pLruNext->pLruPrev = pMemNode;
+	pPrev->pLruNext = pMemNode;
+}
+
 /**
  * Tries to make space for the specified number of bytes on the specified heap.
  * @param size			Number of bytes to free up
  * @return true if any blocks were discarded, false otherwise
  */
 static bool HeapCompact(long size) {
-	const MEM_NODE *pHeap = &g_heapSentinel;
-	MEM_NODE *pCur, *pOldest;
-	uint32 oldest;		// time of the oldest discardable block
-
 	while (g_heapSentinel.size < size) {
+		// the oldest discardable block is at the head of the LRU list,
+		// but blocks used during the current tick are never discarded
+		MEM_NODE *pOldest = g_lruSentinel.pLruNext;
 
-		// find the oldest discardable block
-		oldest = DwGetCurrentTime();
-		pOldest = NULL;
-		for (pCur = pHeap->pNext; pCur != pHeap; pCur = pCur->pNext) {
-			if (pCur->flags == DWM_USED) {
-				// found a non-discarded discardable block
-				if (pCur->lruTime < oldest) {
-					oldest = pCur->lruTime;
-					pOldest = pCur;
-				}
-			}
-		}
-
-		if (pOldest)
+		if (pOldest != &g_lruSentinel && pOldest->lruTime < DwGetCurrentTime()) {
 			// discard the oldest block
 			MemoryDiscard(pOldest);
-		else
+			g_memStats.numDiscards++;
+		} else {
 			// cannot discard any blocks
+			g_memStats.numFailures++;
 			return false;
+		}
 	}
 
 	// we have freed enough memory
@@ -226,11 +260,21 @@ static bool HeapCompact(long size) {
 }
 
 /**
- * Allocates the specified number of bytes from the heap.
- * @param flags			Allocation attributes
+ * Updates the heap usage statistics after an allocation.
+ */
+static void UpdatePeakUsage() {
+	uint32 used = g_heapSize - g_heapSentinel.size;
+	if (used > g_memStats.peakSize)
+		g_memStats.peakSize = used;
+}
+
+/**
+ * Allocates the specified number of bytes from the heap for a discarded node.
+ * @param pNode			Node of the memory object
  * @param size			Number of bytes to allocate
+ * @return true if the memory was allocated, false otherwise
  */
-static MEM_NODE *MemoryAlloc(long size) {
+static bool MemoryAlloc(MEM_NODE *pNode, long size) {
 	MEM_NODE *pHeap = &g_heapSentinel;
 
 #ifdef SCUMM_NEED_ALIGNMENT
@@ -240,12 +284,9 @@ static MEM_NODE *MemoryAlloc(long size) {
 
 	// compact the heap to make up room for 'size' bytes, if necessary
 	if (!HeapCompact(size))
-		return 0;
+		return false;
 
-	// success! we may allocate a new node of the right size
-
-	// Allocate a node.
-	MEM_NODE *pNode = AllocMemNode();
+	// success! we may allocate memory of the right size
 
 	// Allocate memory for the node.
 	pNode->pBaseAddr = (byte *)malloc(size);
@@ -256,6 +297,8 @@ static MEM_NODE *MemoryAlloc(long size) {
 
 	// Subtract size of new block from total
 	g_heapSentinel.size -= size;
+	g_memStats.numAllocs++;
+	UpdatePeakUsage();
 
 #ifdef DEBUG
 	MemoryStats();
@@ -266,7 +309,12 @@ static MEM_NODE *MemoryAlloc(long size) {
 	pNode->lruTime = DwGetCurrentTime() + 1;
 	pNode->size = size;
 
-	// set mnode at the end of the list
+	// the block is discardable until it gets locked
+	LruLink(pNode);
+
+	// move mnode to the end of the list
+	pNode->pNext->pPrev = pNode->pPrev;
+	pNode->pPrev->pNext = pNode->pNext;
 	pNode->pPrev = pHeap->pPrev;
 	pNode->pNext = pHeap;
 
@@ -274,7 +322,7 @@ static MEM_NODE *MemoryAlloc(long size) {
 	pHeap->pPrev->pNext = pNode;
 	pHeap->pPrev = pNode;
 
-	return pNode;
+	return true;
 }
 
 /**
@@ -327,6 +375,8 @@ MEM_NODE *MemoryAllocFixed(long size) {
 
 			// Subtract size of new block from total
 			g_heapSentinel.size -= size;
+			g_memStats.fixedSize += size;
+			UpdatePeakUsage();
 
 			return pNode;
 		}
@@ -353,6 +403,9 @@ void MemoryDiscard(MEM_NODE *pMemNode) {
 		free(pMemNode->pBaseAddr);
 		g_heapSentinel.size += pMemNode->size;
 
+		// the node has nothing left to discard
+		LruUnlink(pMemNode);
+
 #ifdef DEBUG
 		MemoryStats();
 #endif
@@ -380,6 +433,9 @@ void *MemoryLock(MEM_NODE *pMemNode) {
 	// set the lock flag
 	pMemNode->flags |= DWM_LOCKED;
 
+	// locked blocks cannot be discarded
+	LruUnlink(pMemNode);
+
 #ifdef DEBUG
 	MemoryStats();
 #endif
@@ -405,6 +461,10 @@ void MemoryUnlock(MEM_NODE *pMemNode) {
 
 	// update the LRU time
 	pMemNode->lruTime = DwGetCurrentTime();
+
+	// the block is discardable again, unless it is a fixed block
+	if (pMemNode >= g_mnodeList && pMemNode <= g_mnodeList + NUM_MNODES - 1)
+		LruLink(pMemNode);
 }
 
 /**
@@ -413,8 +473,6 @@ void MemoryUnlock(MEM_NODE *pMemNode) {
  * @param size			New size of block
  */
 void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
-	MEM_NODE *pNew;
-
 	// validate mnode pointer
 	assert(pMemNode >= g_mnodeList && pMemNode <= g_mnodeList + NUM_MNODES - 1);
 
@@ -429,25 +487,11 @@ void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
 		assert(pMemNode->flags == (DWM_USED | DWM_DISCARDED));
 		assert(pMemNode->size == 0);
 
-		// unlink the mnode from the current heap
-		pMemNode->pNext->pPrev = pMemNode->pPrev;
-		pMemNode->pPrev->pNext = pMemNode->pNext;
-
-		// allocate a new node
-		pNew = MemoryAlloc(size);
+		// allocate memory for the node
+		bool allocated = MemoryAlloc(pMemNode, size);
 
 		// make sure memory allocated
-		assert(pNew != NULL);
-
-		// copy the node to the current node
-		memcpy(pMemNode, pNew, sizeof(MEM_NODE));
-
-		// relink the mnode into the list
-		pMemNode->pPrev->pNext = pMemNode;
-		pMemNode->pNext->pPrev = pMemNode;
-
-		// free the new node
-		FreeMemNode(pNew);
+		assert(allocated);
 	}
 
 	assert(pMemNode->pBaseAddr);
@@ -460,11 +504,55 @@ void MemoryReAlloc(MEM_NODE *pMemNode, long size) {
 void MemoryTouch(MEM_NODE *pMemNode) {
 	// update the LRU time
 	pMemNode->lruTime = DwGetCurrentTime();
+
+	// and move the block to its new place in the LRU list
+	if (pMemNode->pLruNext) {
+		LruUnlink(pMemNode);
+		LruLink(pMemNode);
+	}
 }
 
 uint8 *MemoryDeref(MEM_NODE *pMemNode) {
 	return pMemNode->pBaseAddr;
 }
 
+/**
+ * Changes the total heap size. Blocks are discarded as needed when the heap
+ * is made smaller, but locked blocks stay allocated even if they exceed
+ * the new size.
+ * @param size			New heap size in bytes
+ */
+void MemorySetHeapSize(uint32 size) {
+	g_heapSentinel.size += (long)size - (long)g_heapSize;
+	g_heapSize = size;
+
+	HeapCompact(0);
+}
+
+/**
+ * Gets the heap usage statistics.
+ * @param pStats		Returns the statistics
+ */
+void MemoryGetStats(MEM_STATS *pStats) {
+	*pStats = g_memStats;
+	pStats->heapSize = g_heapSize;
+	pStats->usedSize = g_heapSize - g_heapSentinel.size;
+	pStats->numNodes = 0;
+	pStats->numLoaded = 0;
+	pStats->numLocked = 0;
+	pStats->lockedSize = 0;
+
+	const MEM_NODE *pHeap = &g_heapSentinel;
+	for (const MEM_NODE *pCur = pHeap->pNext; pCur != pHeap; pCur = pCur->pNext) {
+		pStats->numNodes++;
+		if (!(pCur->flags & DWM_DISCARDED))
+			pStats->numLoaded++;
+		if (pCur->flags & DWM_LOCKED) {
+			pStats->numLocked++;
+			pStats->lockedSize += pCur->size;
+		}
+	}
+}
+
 
 } // End of namespace Tinsel
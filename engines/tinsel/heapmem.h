@@ -30,6 +30,21 @@ namespace Tinsel {
 
 struct MEM_NODE;
 
+// heap usage statistics, as shown by the debugger
+struct MEM_STATS {
+	uint32 heapSize;	// total size of the heap
+	uint32 usedSize;	// bytes currently allocated, including fixed blocks
+	uint32 peakSize;	// largest number of bytes allocated at any time
+	uint32 fixedSize;	// bytes allocated for fixed blocks
+	uint32 lockedSize;	// bytes in locked blocks
+	int numNodes;		// number of movable memory nodes
+	int numLoaded;		// movable nodes which have memory allocated
+	int numLocked;		// movable nodes which are locked
+	uint32 numAllocs;	// number of blocks allocated since startup
+	uint32 numDiscards;	// number of blocks discarded to make room
+	uint32 numFailures;	// number of times not enough could be discarded
+};
+
 
 /*----------------------------------------------------------------------*\
 |*			Memory Function Prototypes			*|
@@ -63,6 +78,12 @@ void MemoryTouch(MEM_NODE *pMemNode);
 // Dereference a given memory node
 uint8 *MemoryDeref(MEM_NODE *pMemNode);
 
+// changes the total size of the heap
+void MemorySetHeapSize(uint32 size);
+
+// gets the heap usage statistics
+void MemoryGetStats(MEM_STATS *pStats);
+
 } // End of namespace Tinsel
 
 #endif
@@ -31,6 +31,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	DCmd_Register("continue",		WRAP_METHOD(Debugger, Cmd_Exit));
 	DCmd_Register("scene",			WRAP_METHOD(Debugger, Cmd_Scene));
 	DCmd_Register("dirty_rects",	WRAP_METHOD(Debugger, Cmd_DirtyRects));
+	DCmd_Register("coroutines",		WRAP_METHOD(Debugger, Cmd_Coroutines));
 }
 
 static int strToInt(const char *s) {
@@ -126,4 +127,16 @@ bool Debugger::Cmd_DirtyRects(int argc, const char **argv) {
 	}
 }
 
+/**
+ * Shows the coroutine scheduler statistics
+ */
+bool Debugger::Cmd_Coroutines(int argc, const char **argv) {
+	Common::CoroutineScheduler::Stats stats = CoroScheduler.getStats();
+
+	DebugPrintf("%d processes active (peak %d), %d in the pool\n", stats.numProcesses, stats.maxProcesses, stats.poolSize);
+	DebugPrintf("%d sleeping, %d waiting, %d run on the last tick\n", stats.numSleeping, stats.numWaiting, stats.numDispatched);
+	DebugPrintf("%d ticks, %d ms total process time (%d ms at most)\n", stats.numTicks, stats.processTime, stats.maxProcessTime);
+	return true;
+}
+
 } // End of namespace Tony
@@ -95,6 +95,84 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+/**
+ * Every conversion between two formats with at most 8 bits per component
+ * only copies bits around or sets them to a constant. The converted color
+ * is thus the OR of the converted bytes of the source color, which can be
+ * looked up in one table of 256 entries per source byte.
+ */
+void buildConversionTable(uint32 *table, const PixelFormat &srcFmt, const PixelFormat &dstFmt) {
+	for (uint i = 0; i < srcFmt.bytesPerPixel; ++i) {
+		for (uint j = 0; j < 256; ++j) {
+			byte a, r, g, b;
+			srcFmt.colorToARGB(j << (i * 8), a, r, g, b);
+			table[i * 256 + j] = dstFmt.ARGBToColor(a, r, g, b);
+		}
+	}
+}
+
+template<typename SrcColor, typename DstColor, bool backward>
+inline void crossBlitLogicTable(byte *dst, const byte *src, const uint w, const uint h,
+                                const uint32 *table, const uint srcDelta, const uint dstDelta) {
+	for (uint y = 0; y < h; ++y) {
+		for (uint x = 0; x < w; ++x) {
+			const uint32 color = *(const SrcColor *)src;
+			uint32 result = table[color & 0xFF] | table[256 + ((color >> 8) & 0xFF)];
+			if (sizeof(SrcColor) == 4)
+				result |= table[512 + ((color >> 16) & 0xFF)] | table[768 + (color >> 24)];
+			*(DstColor *)dst = result;
+
+			if (backward) {
+				src -= sizeof(SrcColor);
+				dst -= sizeof(DstColor);
+			} else {
+				src += sizeof(SrcColor);
+				dst += sizeof(DstColor);
+			}
+		}
+
+		if (backward) {
+			src -= srcDelta;
+			dst -= dstDelta;
+		} else {
+			src += srcDelta;
+			dst += dstDelta;
+		}
+	}
+}
+
+template<typename SrcColor, typename DstColor, bool backward>
+inline void crossBlitLogicConvert(byte *dst, const byte *src, const uint w, const uint h,
+                                  const PixelFormat &srcFmt, const PixelFormat &dstFmt,
+                                  const uint srcDelta, const uint dstDelta) {
+	// Filling the table costs about as much as converting one pixel per
+	// entry, so it only pays off for larger rects. It is kept on the stack
+	// so that crossBlit() can be called from any thread.
+	if (w * h < sizeof(SrcColor) * 256) {
+		crossBlitLogic<SrcColor, DstColor, backward>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+		return;
+	}
+
+	uint32 table[sizeof(SrcColor) * 256];
+	buildConversionTable(table, srcFmt, dstFmt);
+	crossBlitLogicTable<SrcColor, DstColor, backward>(dst, src, w, h, table, srcDelta, dstDelta);
+}
+
+template<typename DstColor>
+inline void crossBlitLogicMap(byte *dst, const byte *src, const uint w, const uint h,
+                              const uint32 *map, const uint srcDelta, const uint dstDelta) {
+	for (uint y = 0; y < h; ++y) {
+		for (uint x = 0; x < w; ++x) {
+			*(DstColor *)dst = map[*src];
+			src -= 1;
+			dst -= sizeof(DstColor);
+		}
+
+		src -= srcDelta;
+		dst -= dstDelta;
+	}
+}
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -129,14 +207,13 @@ bool crossBlit(byte *dst, const byte *src,
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
 
-	// TODO: optimized cases for dstDelta of 0
 	if (dstFmt.bytesPerPixel == 2) {
 		if (srcFmt.bytesPerPixel == 2) {
-			crossBlitLogic<uint16, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogicConvert<uint16, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
 		} else if (srcFmt.bytesPerPixel == 3) {
 			crossBlitLogic3BppSource<uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
 		} else {
-			crossBlitLogic<uint32, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogicConvert<uint32, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
 		}
 	} else if (dstFmt.bytesPerPixel == 4) {
 		if (srcFmt.bytesPerPixel == 2) {
@@ -147,7 +224,7 @@ bool crossBlit(byte *dst, const byte *src,
 			// color than per source color.
 			dst += h * dstPitch - dstDelta - dstFmt.bytesPerPixel;
 			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
-			crossBlitLogic<uint16, uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogicConvert<uint16, uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
 		} else if (srcFmt.bytesPerPixel == 3) {
 			// We need to blit the surface from bottom right to top left here.
 			// This is neeeded, because when we convert to the same memory
@@ -158,7 +235,7 @@ bool crossBlit(byte *dst, const byte *src,
 			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
 			crossBlitLogic3BppSource<uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
 		} else {
-			crossBlitLogic<uint32, uint32, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogicConvert<uint32, uint32, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
 		}
 	} else {
 		return false;
@@ -166,4 +243,28 @@ bool crossBlit(byte *dst, const byte *src,
 	return true;
 }
 
+bool crossBlitMap(byte *dst, const byte *src,
+                  const uint dstPitch, const uint srcPitch,
+                  const uint w, const uint h,
+                  const uint bytesPerPixel, const uint32 *map) {
+	// Error out if conversion is impossible
+	if (bytesPerPixel != 2 && bytesPerPixel != 4)
+		return false;
+
+	const uint srcDelta = (srcPitch - w);
+	const uint dstDelta = (dstPitch - w * bytesPerPixel);
+
+	// We need to blit the surface from bottom right to top left here, so
+	// the surface can be converted in place.
+	dst += h * dstPitch - dstDelta - bytesPerPixel;
+	src += h * srcPitch - srcDelta - 1;
+
+	if (bytesPerPixel == 2)
+		crossBlitLogicMap<uint16>(dst, src, w, h, map, srcDelta, dstDelta);
+	else
+		crossBlitLogicMap<uint32>(dst, src, w, h, map, srcDelta, dstDelta);
+
+	return true;
+}
+
 } // End of namespace Graphics
@@ -72,6 +72,29 @@ bool crossBlit(byte *dst, const byte *src,
                const uint w, const uint h,
                const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * Blits a rectangle of palette indices to a high color format, using the
+ * colors of a precomputed map.
+ *
+ * @param dstbuf		the buffer which will recieve the converted graphics data
+ * @param srcbuf		the buffer containing the palette indices
+ * @param dstpitch		width in bytes of one full line of the dest buffer
+ * @param srcpitch		width in bytes of one full line of the source buffer
+ * @param w				the width of the graphics data
+ * @param h				the height of the graphics data
+ * @param bytesPerPixel	the size of one destination pixel, either 2 or 4
+ * @param map			the destination color of each of the 256 indices
+ * @return				true if conversion completes successfully,
+ *						false if there is an error.
+ *
+ * @note This can convert a surface in place as long as there is enough
+ *       space for the destination, just like crossBlit.
+ */
+bool crossBlitMap(byte *dst, const byte *src,
+                  const uint dstPitch, const uint srcPitch,
+                  const uint w, const uint h,
+                  const uint bytesPerPixel, const uint32 *map);
+
 } // End of namespace Graphics
 
 #endif // GRAPHICS_CONVERSION_H
@@ -28,6 +28,7 @@
 #include "common/endian.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 
 namespace Graphics {
 
@@ -45,19 +46,16 @@ static const uint8 _zigZagOrder[64] = {
 
 JPEGDecoder::JPEGDecoder() : ImageDecoder(),
 	_stream(NULL), _w(0), _h(0), _numComp(0), _components(NULL), _numScanComp(0),
-	_scanComp(NULL), _currentComp(NULL), _rgbSurface(0) {
+	_scanComp(NULL), _currentComp(NULL), _rgbSurface(0),
+	_outputFormat(4, 8, 8, 8, 0, 24, 16, 8, 0) {
 
 	// Initialize the quantization tables
 	for (int i = 0; i < JPEG_MAX_QUANT_TABLES; i++)
 		_quant[i] = NULL;
 
 	// Initialize the Huffman tables
-	for (int i = 0; i < 2 * JPEG_MAX_HUFF_TABLES; i++) {
-		_huff[i].count = 0;
-		_huff[i].values = NULL;
-		_huff[i].sizes = NULL;
-		_huff[i].codes = NULL;
-	}
+	for (int i = 0; i < 2 * JPEG_MAX_HUFF_TABLES; i++)
+		resetHuffmanTable(_huff[i]);
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -72,20 +70,46 @@ const Surface *JPEGDecoder::getSurface() const {
 	if (_rgbSurface)
 		return _rgbSurface;
 
-	// Create an RGBA8888 surface
-	_rgbSurface = new Graphics::Surface();
-	_rgbSurface->create(_w, _h, Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0));
-
 	// Get our component surfaces
 	const Graphics::Surface *yComponent = getComponent(1);
 	const Graphics::Surface *uComponent = getComponent(2);
 	const Graphics::Surface *vComponent = getComponent(3);
 
+	// The color conversion can write 2 and 4 bytes per pixel directly,
+	// other formats go through RGBA8888
+	Graphics::PixelFormat format = _outputFormat;
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		format = Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0);
+
+	_rgbSurface = new Graphics::Surface();
+	_rgbSurface->create(_w, _h, format);
+
 	YUVToRGBMan.convert444(_rgbSurface, Graphics::YUVToRGBManager::kScaleFull, (byte *)yComponent->pixels, (byte *)uComponent->pixels, (byte *)vComponent->pixels, yComponent->w, yComponent->h, yComponent->pitch, uComponent->pitch);
 
+	if (format != _outputFormat) {
+		Graphics::Surface *converted = _rgbSurface->convertTo(_outputFormat);
+		_rgbSurface->free();
+		delete _rgbSurface;
+		_rgbSurface = converted;
+	}
+
 	return _rgbSurface;
 }
 
+void JPEGDecoder::setOutputPixelFormat(const PixelFormat &format) {
+	if (format == _outputFormat)
+		return;
+
+	_outputFormat = format;
+
+	// Convert again on the next getSurface() call
+	if (_rgbSurface) {
+		_rgbSurface->free();
+		delete _rgbSurface;
+		_rgbSurface = 0;
+	}
+}
+
 void JPEGDecoder::destroy() {
 	// Reset member variables
 	_stream = NULL;
@@ -109,17 +133,24 @@ void JPEGDecoder::destroy() {
 		_quant[i] = NULL;
 	}
 
-	// Free the Huffman tables
-	for (int i = 0; i < 2 * JPEG_MAX_HUFF_TABLES; i++) {
-		_huff[i].count = 0;
-		delete[] _huff[i].values; _huff[i].values = NULL;
-		delete[] _huff[i].sizes; _huff[i].sizes = NULL;
-		delete[] _huff[i].codes; _huff[i].codes = NULL;
-	}
+	// Reset the Huffman tables
+	for (int i = 0; i < 2 * JPEG_MAX_HUFF_TABLES; i++)
+		resetHuffmanTable(_huff[i]);
 
 	if (_rgbSurface) {
 		_rgbSurface->free();
 		delete _rgbSurface;
+		_rgbSurface = 0;
+	}
+}
+
+void JPEGDecoder::resetHuffmanTable(HuffmanTable &table) {
+	// An empty table does not decode any code
+	table.count = 0;
+	memset(table.lookup, 0, sizeof(table.lookup));
+	for (int len = 0; len <= 16; len++) {
+		table.maxCode[len] = -1;
+		table.valueOffset[len] = 0;
 	}
 }
 
@@ -298,49 +329,58 @@ bool JPEGDecoder::readDHT() {
 		tableId &= 0xF;
 		uint8 tableNum = (tableId << 1) + tableType;
 
-		// Free the Huffman table
-		delete[] _huff[tableNum].values; _huff[tableNum].values = NULL;
-		delete[] _huff[tableNum].sizes; _huff[tableNum].sizes = NULL;
-		delete[] _huff[tableNum].codes; _huff[tableNum].codes = NULL;
+		if (tableNum >= 2 * JPEG_MAX_HUFF_TABLES) {
+			warning("JPEG: Invalid Huffman table");
+			return false;
+		}
+
+		HuffmanTable &table = _huff[tableNum];
 
 		// Read the number of values for each length
 		uint8 numValues[16];
-		_huff[tableNum].count = 0;
+		table.count = 0;
 		for (int len = 0; len < 16; len++) {
 			numValues[len] = _stream->readByte();
-			_huff[tableNum].count += numValues[len];
+			table.count += numValues[len];
 		}
 
-		// Allocate memory for the current table
-		_huff[tableNum].values = new uint8[_huff[tableNum].count];
-		_huff[tableNum].sizes = new uint8[_huff[tableNum].count];
-		_huff[tableNum].codes = new uint16[_huff[tableNum].count];
+		if (table.count > 256) {
+			warning("JPEG: Invalid Huffman table size %d", table.count);
+			resetHuffmanTable(table);
+			return false;
+		}
 
 		// Read the table contents
+		_stream->read(table.values, table.count);
+
+		// Assign the canonical codes: the codes of each size follow the
+		// shorter ones, in the order of the values
+		memset(table.lookup, 0, sizeof(table.lookup));
+
 		int cur = 0;
-		for (int len = 0; len < 16; len++) {
-			for (int i = 0; i < numValues[len]; i++) {
-				_huff[tableNum].values[cur] = _stream->readByte();
-				_huff[tableNum].sizes[cur] = len + 1;
-				cur++;
+		int32 curCode = 0;
+		for (int len = 1; len <= 16; len++) {
+			table.valueOffset[len] = cur - curCode;
+
+			if (curCode + numValues[len - 1] > (1 << len)) {
+				warning("JPEG: Invalid Huffman code lengths");
+				resetHuffmanTable(table);
+				return false;
 			}
-		}
 
-		// Fill the table of Huffman codes
-		cur = 0;
-		uint16 curCode = 0;
-		uint8 curCodeSize = _huff[tableNum].sizes[0];
-		while (cur < _huff[tableNum].count) {
-			// Increase the code size to fit the request
-			while (_huff[tableNum].sizes[cur] != curCodeSize) {
-				curCode <<= 1;
-				curCodeSize++;
+			for (int i = 0; i < numValues[len - 1]; i++, cur++, curCode++) {
+				if (len > kHuffLookupBits)
+					continue;
+
+				// Every index starting with this code decodes to it
+				int shift = kHuffLookupBits - len;
+				uint16 entry = (len << 8) | table.values[cur];
+				for (int j = 0; j < (1 << shift); j++)
+					table.lookup[(curCode << shift) | j] = entry;
 			}
 
-			// Assign the current code
-			_huff[tableNum].codes[cur] = curCode;
-			curCode++;
-			cur++;
+			table.maxCode[len] = numValues[len - 1] ? curCode - 1 : -1;
+			curCode <<= 1;
 		}
 	}
 
@@ -424,7 +464,9 @@ bool JPEGDecoder::readSOS() {
 	}
 
 	// Entropy coded sequence starts, initialize Huffman decoder
+	_bitsData = 0;
 	_bitsNumber = 0;
+	_bitsMarker = false;
 
 	// Read all the scan MCUs
 	uint16 xMCU = _w / (_maxFactorH * 8);
@@ -455,7 +497,9 @@ bool JPEGDecoder::readSOS() {
 
 				if (interval == 0) {
 					interval = _restartInterval;
-					_bitsNumber = 0;
+
+					// Drop the padding up to the next byte
+					_bitsNumber -= _bitsNumber & 7;
 
 					for (byte i = 0; i < _numScanComp; i++)
 						_scanComp[i]->DCpredictor = 0;
@@ -554,6 +598,14 @@ bool JPEGDecoder::readMCU(uint16 xMCU, uint16 yMCU) {
 void JPEGDecoder::idct1D8x8(int32 src[8], int32 dest[64], int32 ps, int32 half) {
 	int p, n;
 
+	// With only the DC coefficient left, all outputs are the same
+	if (!(src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7])) {
+		int32 dc = ((src[0] << 9) + half) >> ps;
+		for (int i = 0; i < 8; i++)
+			dest[i * 8] = dc;
+		return;
+	}
+
 	src[0] <<= 9;
 	src[1] <<= 7;
 	src[3] *= 181;
@@ -580,12 +632,18 @@ void JPEGDecoder::idct1D8x8(int32 src[8], int32 dest[64], int32 ps, int32 half)
 	dest[7 * 8] = (src[0] - src[1]) >> ps;
 }
 
-void JPEGDecoder::idct2D8x8(int32 block[64]) {
+void JPEGDecoder::idct2D8x8(int32 block[64], uint8 rowMask) {
 	int32 tmp[64];
 
-	// Apply 1D IDCT to rows
-	for (int i = 0; i < 8; i++)
-		idct1D8x8(&block[i * 8], &tmp[i], 9, 1 << 8);
+	// Apply 1D IDCT to rows. Empty rows transform to zeros.
+	for (int i = 0; i < 8; i++) {
+		if (rowMask & (1 << i)) {
+			idct1D8x8(&block[i * 8], &tmp[i], 9, 1 << 8);
+		} else {
+			for (int j = 0; j < 8; j++)
+				tmp[i + j * 8] = 0;
+		}
+	}
 
 	// Apply 1D IDCT to columns
 	for (int i = 0; i < 8; i++)
@@ -593,43 +651,21 @@ void JPEGDecoder::idct2D8x8(int32 block[64]) {
  }
 
 bool JPEGDecoder::readDataUnit(uint16 x, uint16 y) {
-	// Prepare an empty data array
-	int16 readData[64];
-	for (int i = 1; i < 64; i++)
-		readData[i] = 0;
-
-	// Read the DC component
-	readData[0] = _currentComp->DCpredictor + readDC();
-	_currentComp->DCpredictor = readData[0];
-
-	// Read the AC components (stored in Zig-Zag)
-	readAC(readData);
-
-	// Calculate the DCT coefficients from the input sequence
-	int32 block[64];
-	for (uint8 i = 0; i < 64; i++) {
-		// Dequantize
-		int32 val = readData[i];
-		int16 quant = _quant[_currentComp->quantTableSelector][i];
-		val *= quant;
-
-		// Store the normalized coefficients, undoing the Zig-Zag
-		block[_zigZagOrder[i]] = val;
+	const uint16 *quant = _quant[_currentComp->quantTableSelector];
+	if (!quant) {
+		warning("JPEG: Missing quantization table %d", _currentComp->quantTableSelector);
+		return false;
 	}
 
-	// Apply the IDCT
-	idct2D8x8(block);
-
-	// Level shift to make the values unsigned
-	for (int i = 0; i < 64; i++) {
-		block[i] = block[i] + 128;
+	int32 block[64];
+	memset(block, 0, sizeof(block));
 
-		if (block[i] < 0)
-			block[i] = 0;
+	// Read the DC component
+	_currentComp->DCpredictor += readDC();
+	block[0] = _currentComp->DCpredictor * (int16)quant[0];
 
-		if (block[i] > 255)
-			block[i] = 255;
-	}
+	// Read and dequantize the AC components, and apply the IDCT
+	idct2D8x8(block, readAC(block, quant) | 1);
 
 	// Paint the component surface
 	uint8 scalingV = _maxFactorV / _currentComp->factorV;
@@ -639,16 +675,24 @@ bool JPEGDecoder::readDataUnit(uint16 x, uint16 y) {
 	x <<= 3;
 	y <<= 3;
 
-	for (uint8 j = 0; j < 8; j++) {
-		for (uint16 sV = 0; sV < scalingV; sV++) {
-			// Get the beginning of the block line
-			byte *ptr = (byte *)_currentComp->surface.getBasePtr(x * scalingH, (y + j) * scalingV + sV);
+	const int32 *src = block;
+	byte *dst = (byte *)_currentComp->surface.getBasePtr(x * scalingH, y * scalingV);
+	uint16 pitch = _currentComp->surface.pitch;
 
-			for (uint8 i = 0; i < 8; i++) {
-				for (uint16 sH = 0; sH < scalingH; sH++) {
-					*ptr = (byte)(block[j * 8 + i]);
-					ptr++;
-				}
+	for (uint8 j = 0; j < 8; j++, src += 8) {
+		// Level shift to make the values unsigned
+		byte line[8];
+		for (uint8 i = 0; i < 8; i++)
+			line[i] = (byte)CLIP<int32>(src[i] + 128, 0, 255);
+
+		for (uint16 sV = 0; sV < scalingV; sV++, dst += pitch) {
+			if (scalingH == 1) {
+				memcpy(dst, line, 8);
+			} else {
+				byte *ptr = dst;
+				for (uint8 i = 0; i < 8; i++)
+					for (uint16 sH = 0; sH < scalingH; sH++)
+						*ptr++ = line[i];
 			}
 		}
 	}
@@ -667,10 +711,13 @@ int16 JPEGDecoder::readDC() {
 	return readSignedBits(numBits);
 }
 
-void JPEGDecoder::readAC(int16 *out) {
+uint8 JPEGDecoder::readAC(int32 *block, const uint16 *quant) {
 	// AC is type 1
 	uint8 tableNum = (_currentComp->ACentropyTableSelector << 1) + 1;
 
+	// Rows of the block with non-zero coefficients
+	uint8 rowMask = 0;
+
 	// Start reading AC element 1
 	uint8 cur = 1;
 	while (cur < 64) {
@@ -689,23 +736,34 @@ void JPEGDecoder::readAC(int16 *out) {
 		} else {
 			// Skip r values
 			cur += r;
+			if (cur >= 64)
+				break;
 
-			// Read the next value
-			out[cur] = readSignedBits(s);
+			// Read the next value, dequantize it and undo the Zig-Zag
+			uint8 pos = _zigZagOrder[cur];
+			block[pos] = readSignedBits(s) * (int16)quant[cur];
+			rowMask |= 1 << (pos >> 3);
 			cur++;
 		}
 	}
+
+	return rowMask;
 }
 
 int16 JPEGDecoder::readSignedBits(uint8 numBits) {
-	uint16 ret = 0;
+	if (numBits == 0)
+		return 0;
+
 	if (numBits > 16)
 		error("requested %d bits", numBits); //XXX
 
-	// MSB=0 for negatives, 1 for positives
-	for (int i = 0; i < numBits; i++)
-		ret = (ret << 1) + readBit();
+	if (_bitsNumber < numBits)
+		fillBits();
+
+	_bitsNumber -= numBits;
+	uint16 ret = (_bitsData >> _bitsNumber) & ((1 << numBits) - 1);
 
+	// MSB=0 for negatives, 1 for positives
 	// Extend sign bits (PAG109)
 	if (!(ret >> (numBits - 1))) {
 		uint16 tmp = ((uint16)-1 << numBits) + 1;
@@ -714,65 +772,70 @@ int16 JPEGDecoder::readSignedBits(uint8 numBits) {
 	return ret;
 }
 
-// TODO: optimize?
 uint8 JPEGDecoder::readHuff(uint8 table) {
-	bool foundCode = false;
-	uint8 val = 0;
-
-	uint8 cur = 0;
-	uint8 codeSize = 1;
-	uint16 code = readBit();
-	while (!foundCode) {
-		// Prepare a code of the current size
-		while (codeSize < _huff[table].sizes[cur]) {
-			code = (code << 1) + readBit();
-			codeSize++;
-		}
+	const HuffmanTable &huff = _huff[table];
 
-		// Compare the codes of the current size
-		while (!foundCode && (codeSize == _huff[table].sizes[cur])) {
-			if (code == _huff[table].codes[cur]) {
-				// Found the code
-				val = _huff[table].values[cur];
-				foundCode = true;
-			} else {
-				// Continue reading
-				cur++;
-			}
+	if (_bitsNumber < 16)
+		fillBits();
+
+	// Short codes are decoded with a single lookup
+	uint16 entry = huff.lookup[(_bitsData >> (_bitsNumber - kHuffLookupBits)) & ((1 << kHuffLookupBits) - 1)];
+	if (entry) {
+		_bitsNumber -= entry >> 8;
+		return entry & 0xFF;
+	}
+
+	// Longer codes are compared against the largest code of each size
+	int32 code = (_bitsData >> (_bitsNumber - 16)) & 0xFFFF;
+	for (int len = kHuffLookupBits + 1; len <= 16; len++) {
+		int32 lenCode = code >> (16 - len);
+		if (lenCode <= huff.maxCode[len]) {
+			_bitsNumber -= len;
+			return huff.values[lenCode + huff.valueOffset[len]];
 		}
 	}
 
-	return val;
+	// Invalid code, skip it like the longest one
+	warning("JPEG: Invalid Huffman code");
+	_bitsNumber -= 16;
+	return 0;
 }
 
-uint8 JPEGDecoder::readBit() {
-	// Read a whole byte if necessary
-	if (_bitsNumber == 0) {
-		_bitsData = _stream->readByte();
-		_bitsNumber = 8;
-
-		// Detect markers
-		if (_bitsData == 0xFF) {
-			uint8 byte2 = _stream->readByte();
-
-			// A stuffed 0 validates the previous byte
-			if (byte2 != 0) {
-				if (byte2 == 0xDC) {
-					// DNL marker: Define Number of Lines
-					// TODO: terminate scan
-					warning("DNL marker detected: terminate scan");
-				} else if (byte2 >= 0xD0 && byte2 <= 0xD7) {
+void JPEGDecoder::fillBits() {
+	// Keep at least 16 bits available
+	while (_bitsNumber <= 24) {
+		byte data = 0;
+
+		if (!_bitsMarker && !_stream->eos()) {
+			data = _stream->readByte();
+
+			// Detect markers
+			while (data == 0xFF) {
+				uint8 byte2 = _stream->readByte();
+
+				// A stuffed 0 validates the previous byte
+				if (byte2 == 0)
+					break;
+
+				if (byte2 >= 0xD0 && byte2 <= 0xD7) {
 					debug(7, "RST%d marker detected", byte2 & 7);
-					_bitsData = _stream->readByte();
+					data = _stream->readByte();
 				} else {
-					warning("Error: marker 0x%02X read in entropy data", byte2);
+					// Any other marker ends the entropy coded data. Leave
+					// it for loadStream() and pad the data with zeros.
+					if (byte2 == 0xDC)
+						warning("DNL marker detected: terminate scan");
+
+					_stream->seek(-2, SEEK_CUR);
+					_bitsMarker = true;
+					data = 0;
 				}
 			}
 		}
-	}
-	_bitsNumber--;
 
-	return (_bitsData & (1 << _bitsNumber)) ? 1 : 0;
+		_bitsData = (_bitsData << 8) | data;
+		_bitsNumber += 8;
+	}
 }
 
 const Surface *JPEGDecoder::getComponent(uint c) const {
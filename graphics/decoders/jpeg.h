@@ -31,6 +31,7 @@
 #ifndef GRAPHICS_JPEG_H
 #define GRAPHICS_JPEG_H
 
+#include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/decoders/image_decoder.h"
 
@@ -40,8 +41,6 @@ class SeekableReadStream;
 
 namespace Graphics {
 
-struct PixelFormat;
-
 #define JPEG_MAX_QUANT_TABLES 4
 #define JPEG_MAX_HUFF_TABLES 2
 
@@ -60,6 +59,15 @@ public:
 	uint16 getHeight() const { return _h; }
 	const Surface *getComponent(uint c) const;
 
+	/**
+	 * Set the pixel format of the surface returned by getSurface().
+	 *
+	 * The color conversion writes straight into this format, so callers
+	 * do not need to convert the returned surface again. The default is
+	 * RGBA8888.
+	 */
+	void setOutputPixelFormat(const PixelFormat &format);
+
 private:
 	Common::SeekableReadStream *_stream;
 	uint16 _w, _h;
@@ -69,6 +77,7 @@ private:
 	// a getSurface() call while still upholding the
 	// const requirement in other ImageDecoders
 	mutable Graphics::Surface *_rgbSurface;
+	PixelFormat _outputFormat;
 
 	// Image components
 	uint8 _numComp;
@@ -103,11 +112,22 @@ private:
 	uint16 *_quant[JPEG_MAX_QUANT_TABLES];
 
 	// Huffman tables
+	enum {
+		kHuffLookupBits = 9
+	};
+
 	struct HuffmanTable {
-		uint8 count;
-		uint8 *values;
-		uint8 *sizes;
-		uint16 *codes;
+		uint16 count;
+		uint8 values[256];
+
+		// Codes of up to kHuffLookupBits bits, indexed by the next bits
+		// of the stream: (size << 8) | value, or 0 for longer codes
+		uint16 lookup[1 << kHuffLookupBits];
+
+		// Largest code of each size (-1 if none) and the offset of its
+		// values relative to the code, for the longer codes
+		int32 maxCode[17];
+		int32 valueOffset[17];
 	} _huff[2 * JPEG_MAX_HUFF_TABLES];
 
 	// Marker read functions
@@ -122,18 +142,23 @@ private:
 	bool readMCU(uint16 xMCU, uint16 yMCU);
 	bool readDataUnit(uint16 x, uint16 y);
 	int16 readDC();
-	void readAC(int16 *out);
+	uint8 readAC(int32 *block, const uint16 *quant);
 	int16 readSignedBits(uint8 numBits);
 
 	// Huffman decoding
+	static void resetHuffmanTable(HuffmanTable &table);
 	uint8 readHuff(uint8 table);
-	uint8 readBit();
-	uint8 _bitsData;
+
+	// Entropy coded data, buffered a byte at a time in the low
+	// _bitsNumber bits of _bitsData
+	void fillBits();
+	uint32 _bitsData;
 	uint8 _bitsNumber;
+	bool _bitsMarker;
 
 	// Inverse Discrete Cosine Transformation
 	static void idct1D8x8(int32 src[8], int32 dest[64], int32 ps, int32 half);
-	static void idct2D8x8(int32 block[64]);
+	static void idct2D8x8(int32 block[64], uint8 rowMask);
 };
 
 } // End of Graphics namespace
@@ -31,9 +31,10 @@
 #include "graphics/font.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
+#include "common/debug.h"
 #include "common/singleton.h"
 #include "common/stream.h"
-#include "common/hashmap.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -122,25 +123,46 @@ private:
 	int _width, _height;
 	int _ascent, _descent;
 
+	enum {
+		kAtlasSize = 256,
+		kKerningUnknown = -0x8000
+	};
+
+	/**
+	 * Glyphs are only rendered when they are used for the first time. Their
+	 * images are packed into shared atlas surfaces.
+	 */
 	struct Glyph {
-		Surface image;
+		bool cached;
+		bool valid;
+		int page;
+		int x, y, w, h;
 		int xOffset, yOffset;
 		int advance;
 	};
 
-	bool cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr);
-	typedef Common::HashMap<byte, Glyph> GlyphCache;
-	GlyphCache _glyphs;
+	const Glyph *getGlyph(byte chr) const;
+	bool cacheGlyph(Glyph &glyph, FT_UInt slot) const;
+	void allocateAtlasSpace(Glyph &glyph) const;
 
+	mutable Glyph _glyphs[256];
 	FT_UInt _glyphSlots[256];
 
+	mutable Common::Array<Surface *> _atlas;
+	mutable int _atlasX, _atlasY, _shelfHeight;
+	mutable uint _glyphCount;
+
+	// Kerning offsets for each left character, allocated when first needed
+	mutable int16 *_kerning[256];
+
 	bool _monochrome;
 	bool _hasKerning;
 };
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _glyphSlots(), _monochrome(false), _hasKerning(false) {
+      _descent(0), _glyphs(), _glyphSlots(), _atlas(), _atlasX(0), _atlasY(0), _shelfHeight(0),
+      _glyphCount(0), _kerning(), _monochrome(false), _hasKerning(false) {
 }
 
 TTFFont::~TTFFont() {
@@ -150,8 +172,13 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		for (uint i = 0; i < _atlas.size(); ++i) {
+			_atlas[i]->free();
+			delete _atlas[i];
+		}
+
+		for (uint i = 0; i < 256; ++i)
+			delete[] _kerning[i];
 
 		_initialized = false;
 	}
@@ -212,29 +239,42 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, uint dpi, bool
 	_height = _ascent - _descent + 1;
 
 	if (!mapping) {
-		// Load all ISO-8859-1 characters.
-		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], _glyphSlots[i], i))
-				_glyphSlots[i] = 0;
-		}
+		// Look up all ISO-8859-1 characters.
+		for (uint i = 0; i < 256; ++i)
+			_glyphSlots[i] = FT_Get_Char_Index(_face, i);
 	} else {
 		for (uint i = 0; i < 256; ++i) {
 			const uint32 unicode = mapping[i] & 0x7FFFFFFF;
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
-			// Check whether loading an important glyph fails and error out if
+			// Check whether an important glyph is missing and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], _glyphSlots[i], unicode)) {
-				_glyphSlots[i] = 0;
-				if (isRequired)
-					return false;
+			_glyphSlots[i] = FT_Get_Char_Index(_face, unicode);
+			if (!_glyphSlots[i] && isRequired) {
+				delete[] _ttfFile;
+				_ttfFile = 0;
+
+				g_ttf.closeFont(_face);
+
+				return false;
 			}
 		}
 	}
 
-	_initialized = (_glyphs.size() != 0);
+	_initialized = true;
 	return _initialized;
 }
 
+const TTFFont::Glyph *TTFFont::getGlyph(byte chr) const {
+	Glyph &glyph = _glyphs[chr];
+
+	if (!glyph.cached) {
+		glyph.cached = true;
+		glyph.valid = _glyphSlots[chr] && cacheGlyph(glyph, _glyphSlots[chr]);
+	}
+
+	return glyph.valid ? &glyph : 0;
+}
+
 int TTFFont::getFontHeight() const {
 	return _height;
 }
@@ -244,11 +284,11 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(byte chr) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = getGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(byte left, byte right) const {
@@ -261,9 +301,20 @@ int TTFFont::getKerningOffset(byte left, byte right) const {
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
-	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	int16 *&kerning = _kerning[left];
+	if (!kerning) {
+		kerning = new int16[256];
+		for (uint i = 0; i < 256; ++i)
+			kerning[i] = kKerningUnknown;
+	}
+
+	if (kerning[right] == kKerningUnknown) {
+		FT_Vector kerningVector;
+		FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
+		kerning[right] = kerningVector.x / 64;
+	}
+
+	return kerning[right];
 }
 
 namespace {
@@ -305,11 +356,12 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyphEntry = getGlyph(chr);
+	if (!glyphEntry || glyphEntry->page < 0)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = *glyphEntry;
+	const Surface &image = *_atlas[glyph.page];
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -319,10 +371,10 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.w;
+	int h = glyph.h;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getBasePtr(0, 0);
+	const uint8 *srcPos = (const uint8 *)image.getBasePtr(glyph.x, glyph.y);
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -338,7 +390,7 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * image.pitch;
 		h += y;
 		y = 0;
 	}
@@ -367,19 +419,47 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += image.pitch;
 		}
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, image.pitch, w, h, color, dst->format);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, image.pitch, w, h, color, dst->format);
 	}
 }
 
-bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
-	slot = FT_Get_Char_Index(_face, chr);
-	if (!slot)
-		return false;
+void TTFFont::allocateAtlasSpace(Glyph &glyph) const {
+	// Glyphs are placed next to each other on shelves as high as the
+	// highest glyph on them.
+	if (!_atlas.empty() && _atlasX + glyph.w > _atlas.back()->w) {
+		_atlasX = 0;
+		_atlasY += _shelfHeight;
+		_shelfHeight = 0;
+	}
+
+	if (_atlas.empty() || _atlasY + glyph.h > _atlas.back()->h || glyph.w > _atlas.back()->w) {
+		Surface *page = new Surface();
+		page->create(MAX<int>(kAtlasSize, glyph.w), MAX<int>(kAtlasSize, glyph.h), PixelFormat::createFormatCLUT8());
+		memset(page->pixels, 0, page->h * page->pitch);
+		_atlas.push_back(page);
+
+		_atlasX = _atlasY = _shelfHeight = 0;
+
+		uint memory = 0;
+		for (uint i = 0; i < _atlas.size(); ++i)
+			memory += _atlas[i]->h * _atlas[i]->pitch;
+		debug(5, "TTFFont: %d glyphs cached in %d atlas pages, using %d bytes", _glyphCount, _atlas.size(), memory);
+	}
+
+	glyph.page = _atlas.size() - 1;
+	glyph.x = _atlasX;
+	glyph.y = _atlasY;
+
+	_atlasX += glyph.w;
+	_shelfHeight = MAX(_shelfHeight, glyph.h);
+}
+
+bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt slot) const {
 
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticable in FreeSansBold.ttf, where otherwise the
@@ -413,7 +493,25 @@ bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
 	}
 
 	const FT_Bitmap &bitmap = _face->glyph->bitmap;
-	glyph.image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
+	glyph.w = bitmap.width;
+	glyph.h = bitmap.rows;
+
+	// Blank glyphs, like spaces, do not need any atlas space
+	if (!glyph.w || !glyph.h) {
+		glyph.page = -1;
+		++_glyphCount;
+		return true;
+	}
+
+	if (bitmap.pixel_mode != FT_PIXEL_MODE_MONO && bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
+		return false;
+	}
+
+	allocateAtlasSpace(glyph);
+	++_glyphCount;
+
+	Surface &image = *_atlas[glyph.page];
 
 	const uint8 *src = bitmap.buffer;
 	int srcPitch = bitmap.pitch;
@@ -422,41 +520,36 @@ bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getBasePtr(0, 0);
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
+	uint8 *dst = (uint8 *)image.getBasePtr(glyph.x, glyph.y);
 
 	switch (bitmap.pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
-		for (int y = 0; y < bitmap.rows; ++y) {
+		for (int y = 0; y < glyph.h; ++y) {
 			const uint8 *curSrc = src;
 			uint8 mask = 0;
 
-			for (int x = 0; x < bitmap.width; ++x) {
+			for (int x = 0; x < glyph.w; ++x) {
 				if ((x % 8) == 0)
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += image.pitch;
 			src += srcPitch;
 		}
 		break;
 
 	case FT_PIXEL_MODE_GRAY:
-		for (int y = 0; y < bitmap.rows; ++y) {
-			memcpy(dst, src, bitmap.width);
-			dst += glyph.image.pitch;
+		for (int y = 0; y < glyph.h; ++y) {
+			memcpy(dst, src, glyph.w);
+			dst += image.pitch;
 			src += srcPitch;
 		}
 		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
-		return false;
 	}
 
 	return true;
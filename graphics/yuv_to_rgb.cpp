@@ -192,6 +192,9 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+// The 444 and 420 kernels are bound by the three rgbToPix lookups per pixel.
+// Unrolling them, or combining two 16 bit pixels into one 32 bit write, was
+// measured to be slower than these plain loops, so they are left as they are.
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -298,19 +301,20 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 		convertYUV420ToRGB<uint32>((byte *)dst->pixels, dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
-#define READ_QUAD(ptr, prefix) \
-	byte prefix##A = ptr[index]; \
-	byte prefix##B = ptr[index + 1]; \
-	byte prefix##C = ptr[index + uvPitch]; \
-	byte prefix##D = ptr[index + uvPitch + 1]
-
-#define DO_INTERPOLATION(out) \
-	out = (out##A * (4 - xDiff) * (4 - yDiff) + out##B * xDiff * (4 - yDiff) + \
-			out##C * yDiff * (4 - xDiff) + out##D * xDiff * yDiff) >> 4
+// The chroma values are interpolated bilinearly, based on the algorithm
+// found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
+// Each row first blends the two chroma rows around it, which leaves one
+// column value per chroma sample. The four pixels between two columns
+// then step linearly from the left column to the right one:
+// (left * (4 - xDiff) + right * xDiff) == 4 * left + xDiff * (right - left)
+#define READ_COLUMN(ptr, index) \
+	(ptr[index] * (4 - yDiff) + ptr[(index) + uvPitch] * yDiff)
 
 #define DO_YUV410_PIXEL() \
-	DO_INTERPOLATION(u); \
-	DO_INTERPOLATION(v); \
+	u = uSum >> 4; \
+	v = vSum >> 4; \
+	uSum += uStep; \
+	vSum += vStep; \
 	\
 	cr_r  = Cr_r_tab[v]; \
 	crb_g = Cr_g_tab[v] + Cb_g_tab[u]; \
@@ -318,9 +322,7 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	\
 	PUT_PIXEL(*ySrc, dstPtr); \
 	dstPtr += sizeof(PixelInt); \
-	\
-	ySrc++; \
-	xDiff++
+	ySrc++
 
 template<typename PixelInt>
 void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
@@ -334,27 +336,31 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	int quarterWidth = yWidth >> 2;
 
 	for (int y = 0; y < yHeight; y++) {
+		int yDiff = y & 3;
+		const byte *uRow = uSrc + (y >> 2) * uvPitch;
+		const byte *vRow = vSrc + (y >> 2) * uvPitch;
+
+		int uLeft = READ_COLUMN(uRow, 0);
+		int vLeft = READ_COLUMN(vRow, 0);
+
 		for (int x = 0; x < quarterWidth; x++) {
-			// Perform bilinear interpolation on the the chroma values
-			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
-			// Feel free to optimize further
-			int targetY = y >> 2;
-			int xDiff = 0;
-			int yDiff = y & 3;
-			int index = targetY * uvPitch + x;
+			int uRight = READ_COLUMN(uRow, x + 1);
+			int vRight = READ_COLUMN(vRow, x + 1);
+			int uSum = uLeft << 2, uStep = uRight - uLeft;
+			int vSum = vLeft << 2, vStep = vRight - vLeft;
 
 			// Declare some variables for the following macros
 			byte u, v;
 			int16 cr_r, crb_g, cb_b;
 			register const uint32 *L;
 
-			READ_QUAD(uSrc, u);
-			READ_QUAD(vSrc, v);
-
 			DO_YUV410_PIXEL();
 			DO_YUV410_PIXEL();
 			DO_YUV410_PIXEL();
 			DO_YUV410_PIXEL();
+
+			uLeft = uRight;
+			vLeft = vRight;
 		}
 
 		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
@@ -362,8 +368,7 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
-#undef READ_QUAD
-#undef DO_INTERPOLATION
+#undef READ_COLUMN
 #undef DO_YUV410_PIXEL
 
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
@@ -22,6 +22,9 @@
 #include "gui/saveload-dialog.h"
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
+#include "common/system.h"
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
@@ -29,6 +32,7 @@
 #include "gui/widgets/edittext.h"
 
 #include "graphics/scaler.h"
+#include "graphics/thumbnail.h"
 
 namespace GUI {
 
@@ -104,7 +108,78 @@ int SaveLoadChooserDialog::run(const Common::String &target, const MetaEngine *m
 	_saveDateSupport = _metaInfoSupport && _metaEngine->hasFeature(MetaEngine::kSavesSupportCreationDate);
 	_playTimeSupport = _metaInfoSupport && _metaEngine->hasFeature(MetaEngine::kSavesSupportPlayTime);
 
-	return runIntern();
+	int result = runIntern();
+
+	// Write out the meta infos cached while the dialog was shown
+	g_system->getSavefileManager()->flushCachedMetaInfos();
+
+	return result;
+}
+
+SaveStateDescriptor SaveLoadChooserDialog::queryMetaInfos(const SaveStateDescriptor &save) {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const int slot = save.getSaveSlot();
+
+	// Each entry starts with the description listed for the save state. The
+	// entry is stale when that has changed. Savefiles replaced outside of
+	// ScummVM are mostly caught by the savefile manager already.
+	Common::SeekableReadStream *in = saveFileMan->openCachedMetaInfo(_target, slot);
+	if (in) {
+		Common::String listedDescription;
+		for (uint16 size = in->readUint16LE(); size && !in->eos(); --size)
+			listedDescription += (char)in->readByte();
+
+		SaveStateDescriptor desc;
+		bool valid = listedDescription == save.getDescription() && desc.loadMetaInfos(*in);
+		delete in;
+
+		if (valid) {
+			desc.setSaveSlot(slot);
+			return desc;
+		}
+	}
+
+	return cacheMetaInfos(*_metaEngine, _target, slot, save.getDescription());
+}
+
+SaveStateDescriptor SaveLoadChooserDialog::cacheMetaInfos(const MetaEngine &metaEngine, const Common::String &target, int slot, const Common::String &description) {
+	SaveStateDescriptor desc = metaEngine.querySaveMetaInfos(target.c_str(), slot);
+	if (desc.getSaveSlot() != slot)
+		return desc;
+
+	// Entries are dropped when this file is written or removed
+	const Common::String savefile = metaEngine.getSavefileName(target.c_str(), slot);
+	if (savefile.empty())
+		return desc;
+
+	// Store the thumbnail at the size it is shown with, so it does not
+	// need to be scaled down again.
+	const Graphics::Surface *thumb = desc.getThumbnail();
+	if (thumb && (thumb->w > kThumbnailWidth || thumb->h > kThumbnailHeight2)) {
+		int w = kThumbnailWidth;
+		int h = thumb->h * kThumbnailWidth / thumb->w;
+		if (h > kThumbnailHeight2) {
+			h = kThumbnailHeight2;
+			w = thumb->w * kThumbnailHeight2 / thumb->h;
+		}
+		desc.setThumbnail(Graphics::scale(*thumb, w, h));
+	}
+
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	out.writeUint16LE(description.size());
+	out.writeString(description);
+	if (desc.saveMetaInfos(out))
+		g_system->getSavefileManager()->storeCachedMetaInfo(target, slot, savefile, out.getData(), out.size());
+
+	return desc;
+}
+
+void SaveLoadChooserDialog::updateMetaInfos(const MetaEngine &metaEngine, const Common::String &target, int slot, const Common::String &description) {
+	if (!metaEngine.hasFeature(MetaEngine::kSavesSupportMetaInfo))
+		return;
+
+	cacheMetaInfos(metaEngine, target, slot, description);
+	g_system->getSavefileManager()->flushCachedMetaInfos();
 }
 
 void SaveLoadChooserDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
@@ -361,7 +436,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot());
+		SaveStateDescriptor desc = queryMetaInfos(_saveList[selItem]);
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -853,7 +928,7 @@ void SaveLoadChooserGrid::updateSaves() {
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
 		const uint saveSlot = _saveList[i].getSaveSlot();
 
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
+		SaveStateDescriptor desc = queryMetaInfos(_saveList[i]);
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
 		const Graphics::Surface *thumbnail = desc.getThumbnail();
@@ -66,9 +66,28 @@ public:
 	int run(const Common::String &target, const MetaEngine *metaEngine);
 	virtual const Common::String &getResultString() const = 0;
 
+	/**
+	 * Update the cached meta infos of a slot after the game has been saved
+	 * to it.
+	 */
+	static void updateMetaInfos(const MetaEngine &metaEngine, const Common::String &target, int slot, const Common::String &description);
+
 protected:
 	virtual int runIntern() = 0;
 
+	/**
+	 * Query the meta infos of a listed save state. They are taken from the
+	 * savefile manager's metadata index if possible, so that the savefile
+	 * does not need to be opened, and added to it otherwise.
+	 */
+	SaveStateDescriptor queryMetaInfos(const SaveStateDescriptor &save);
+
+	/**
+	 * Query the meta infos of a slot from the engine and add them to the
+	 * metadata index.
+	 */
+	static SaveStateDescriptor cacheMetaInfos(const MetaEngine &metaEngine, const Common::String &target, int slot, const Common::String &description);
+
 	const bool				_saveMode;
 	const MetaEngine		*_metaEngine;
 	bool					_delSupport;
@@ -113,4 +113,15 @@ const Common::String &SaveLoadChooser::getResultString() const {
 	return _impl->getResultString();
 }
 
+void SaveLoadChooser::updateMetaInfos(int slot, const String &description) {
+	const Common::String gameId = ConfMan.get("gameid");
+
+	const EnginePlugin *plugin = 0;
+	EngineMan.findGame(gameId, &plugin);
+	if (!plugin)
+		return;
+
+	SaveLoadChooserDialog::updateMetaInfos(**plugin, ConfMan.getActiveDomainName(), slot, description);
+}
+
 } // End of namespace GUI
@@ -54,6 +54,12 @@ public:
 
 	const Common::String &getResultString() const;
 
+	/**
+	 * Update the cached meta infos of a slot of the currently active
+	 * target after the game has been saved to it.
+	 */
+	void updateMetaInfos(int slot, const String &description);
+
 	/**
 	 * Creates a default save description for the specified slot. Depending
 	 * on the ScummVM configuration this might be a simple "Slot #" description
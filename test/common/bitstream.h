@@ -149,4 +149,46 @@ class BitStreamTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(bs.peekBits(5), 12u);
 		TS_ASSERT(!bs.eos());
 	}
+
+	void test_peek_bits_across_values() {
+		byte contents[] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0 };
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::BitStream32BEMSB bs(ms);
+		TS_ASSERT_EQUALS(bs.getBits(28), 0x1234567u);
+		TS_ASSERT_EQUALS(bs.peekBits(12), 0x89Au);
+		TS_ASSERT_EQUALS(bs.pos(), 28u);
+		TS_ASSERT_EQUALS(bs.getBits(12), 0x89Au);
+		TS_ASSERT_EQUALS(bs.peekBits(24), 0xBCDEF0u);
+		TS_ASSERT_EQUALS(bs.getBits(24), 0xBCDEF0u);
+		TS_ASSERT(bs.eos());
+	}
+
+	void test_peek_bits_across_values_lsb() {
+		byte contents[] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0 };
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::BitStream32LELSB bs(ms);
+		TS_ASSERT_EQUALS(bs.getBits(28), 0x8563412u);
+		TS_ASSERT_EQUALS(bs.peekBits(12), 0x9A7u);
+		TS_ASSERT_EQUALS(bs.pos(), 28u);
+		TS_ASSERT_EQUALS(bs.getBits(12), 0x9A7u);
+		TS_ASSERT_EQUALS(bs.getBits(24), 0xF0DEBCu);
+		TS_ASSERT(bs.eos());
+	}
+
+	void test_peek_bits_past_end() {
+		byte contents[] = { 'a' };
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::BitStream8MSB bs(ms);
+		bs.skip(5);
+		TS_ASSERT_EQUALS(bs.peekBits(5), 4u);
+		TS_ASSERT_EQUALS(bs.pos(), 5u);
+		TS_ASSERT_EQUALS(bs.getBits(3), 1u);
+		TS_ASSERT(bs.eos());
+	}
 };
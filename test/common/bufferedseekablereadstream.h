@@ -81,4 +81,36 @@ class BufferedSeekableReadStreamTestSuite : public CxxTest::TestSuite {
 
 		delete &ssrs;
 	}
+
+	void test_read_window() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+
+		Common::SeekableReadStream &ssrs
+			= *Common::wrapBufferedSeekableReadStream(&ms, 4, DisposeAfterUse::NO);
+
+		// Nothing is buffered yet
+		uint32 size;
+		ssrs.getReadWindow(size);
+		TS_ASSERT_EQUALS(size, 0U);
+
+		TS_ASSERT_EQUALS(ssrs.readByte(), 0);
+		const byte *window = ssrs.getReadWindow(size);
+		TS_ASSERT_EQUALS(size, 3U);
+		TS_ASSERT_EQUALS(window[0], 1);
+
+		ssrs.consumeReadWindow(2);
+		TS_ASSERT_EQUALS(ssrs.pos(), 3);
+
+		// Crosses the end of the buffered data
+		TS_ASSERT_EQUALS(ssrs.readUint16BE(), 0x0304);
+		TS_ASSERT_EQUALS(ssrs.pos(), 5);
+		TS_ASSERT_EQUALS(ssrs.readUint32LE(), 0x08070605UL);
+		TS_ASSERT_EQUALS(ssrs.pos(), 9);
+
+		ssrs.seek(-2, SEEK_CUR);
+		TS_ASSERT_EQUALS(ssrs.readByte(), 7);
+
+		delete &ssrs;
+	}
 };
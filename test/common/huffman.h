@@ -1,4 +1,5 @@
 #include <cxxtest/TestSuite.h>
+
 #include "common/huffman.h"
 #include "common/bitstream.h"
 #include "common/memstream.h"
@@ -10,6 +11,75 @@
 * TODO: It could be improved by generating one at runtime.
 */
 class HuffmanTestSuite : public CxxTest::TestSuite {
+	enum {
+		kSymbolCount = 300,
+		kMaxLength = 18,
+		kStreamSymbols = 100000
+	};
+
+	uint8 _lengths[kSymbolCount];
+	uint32 _codes[kSymbolCount];
+	uint32 _stream[kStreamSymbols];
+
+	/**
+	 * Generate a complete canonical code with long codes, by splitting
+	 * random leaves of a code tree.
+	 */
+	void generateCode() {
+		uint32 seed = 1;
+		uint32 count = 1;
+		_lengths[0] = 0;
+
+		while (count < kSymbolCount) {
+			seed = seed * 1103515245 + 12345;
+			uint32 leaf = (seed >> 16) % count;
+			if (_lengths[leaf] >= kMaxLength)
+				continue;
+
+			_lengths[leaf]++;
+			_lengths[count++] = _lengths[leaf];
+		}
+
+		uint32 code = 0;
+		for (uint8 length = 1; length <= kMaxLength; length++) {
+			for (uint32 i = 0; i < kSymbolCount; i++)
+				if (_lengths[i] == length)
+					_codes[i] = code++;
+			code <<= 1;
+		}
+
+		for (uint32 i = 0; i < kStreamSymbols; i++) {
+			seed = seed * 1103515245 + 12345;
+			_stream[i] = (seed >> 16) % kSymbolCount;
+		}
+	}
+
+	/**
+	 * Encode the symbol stream, packing the bits into bytes in MSB to LSB
+	 * or LSB to MSB order.
+	 */
+	byte *encode(bool msb2lsb, uint32 &size) {
+		size = kStreamSymbols * kMaxLength / 8 + 4;
+		byte *data = new byte[size];
+		memset(data, 0, size);
+
+		uint32 pos = 0;
+		for (uint32 i = 0; i < kStreamSymbols; i++) {
+			uint8 length = _lengths[_stream[i]];
+			uint32 code = _codes[_stream[i]];
+
+			for (uint8 j = 0; j < length; j++, pos++) {
+				uint32 bit = (code >> (length - 1 - j)) & 1;
+				if (msb2lsb)
+					data[pos / 8] |= bit << (7 - pos % 8);
+				else
+					data[pos / 8] |= bit << (pos % 8);
+			}
+		}
+
+		return data;
+	}
+
 	public:
 	void test_get_with_full_symbols() {
 
@@ -141,4 +211,112 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	void test_get_lsb() {
+
+		/*
+		 * An LSB to MSB bit stream hands out the codes' bits starting with
+		 * their LSB, so these are the codes of test_get_with_full_symbols
+		 * with their bits reversed:
+		 * 0xA=010
+		 * 0xB=110
+		 * 0xC=11
+		 * 0xD=00
+		 * 0xE=01
+		 *
+		 * The bits are read in the same order as in test_get_with_full_symbols,
+		 * 010 011 11 00 10 00 00 = A B C D E D D
+		 * but starting with the LSB of each byte:
+		 *  = 1111 0010, 0000 0100 = 0xF2 0x04
+		 */
+
+		uint32 codeCount = 5;
+		const uint8 lengths[] = {3,3,2,2,2};
+		const uint32 codes[]  = {0x2, 0x6, 0x3, 0x0, 0x1};
+		const uint32 symbols[]  = {0xA, 0xB, 0xC, 0xD, 0xE};
+
+		Common::Huffman h(0, codeCount, codes, lengths, symbols);
+
+		byte input[] = {0xF2, 0x04};
+		uint32 expected[] = {0xA, 0xB, 0xC, 0xD, 0xE, 0xD, 0xD};
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8LSB bs(ms);
+
+		for (int i = 0; i < ARRAYSIZE(expected); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+		TS_ASSERT(bs.eos());
+	}
+
+	void test_shadowed_codes() {
+
+		/*
+		 * Codes sharing a prefix with a shorter code, or identical to an
+		 * earlier code of the same length, are never matched.
+		 * 0=1, 1=01, 2=1 (shadowed by 0), 3=10 (shadowed by 0), 4=00
+		 */
+
+		uint32 codeCount = 5;
+		const uint8 lengths[] = {1,2,1,2,2};
+		const uint32 codes[]  = {0x1, 0x1, 0x1, 0x2, 0x0};
+
+		Common::Huffman h(0, codeCount, codes, lengths, 0);
+
+		// 1 01 00 1 1 0 = 0xA6
+		byte input[] = {0xA6};
+		uint32 expected[] = {0, 1, 4, 0, 0};
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8MSB bs(ms);
+
+		for (int i = 0; i < ARRAYSIZE(expected); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+	}
+
+	void test_long_codes() {
+
+		/*
+		 * Decode a long stream of codes of up to 18 bits, which need more
+		 * than one table lookup, in both bit orders. The results have to
+		 * match the symbols encoded.
+		 */
+
+		generateCode();
+
+		Common::Huffman h(0, kSymbolCount, _codes, _lengths, 0);
+
+		// LSB to MSB bit streams hand out the codes' bits starting with their LSB
+		uint32 reversedCodes[kSymbolCount];
+		for (uint32 i = 0; i < kSymbolCount; i++) {
+			reversedCodes[i] = 0;
+			for (uint8 j = 0; j < _lengths[i]; j++)
+				reversedCodes[i] |= ((_codes[i] >> j) & 1) << (_lengths[i] - 1 - j);
+		}
+
+		Common::Huffman reversed(0, kSymbolCount, reversedCodes, _lengths, 0);
+
+		uint32 size;
+		byte *msbData = encode(true, size);
+		byte *lsbData = encode(false, size);
+
+		Common::MemoryReadStream msbStream(msbData, size);
+		Common::BitStream8MSB msb(msbStream);
+		Common::MemoryReadStream lsbStream(lsbData, size);
+		Common::BitStream8LSB lsb(lsbStream);
+
+		uint32 errors = 0;
+		for (uint32 i = 0; i < kStreamSymbols; i++)
+			if (h.getSymbol(msb) != _stream[i])
+				errors++;
+
+		for (uint32 i = 0; i < kStreamSymbols; i++)
+			if (reversed.getSymbol(lsb) != _stream[i])
+				errors++;
+
+		TS_ASSERT_EQUALS(errors, 0U);
+		TS_ASSERT_EQUALS(msb.pos(), lsb.pos());
+
+		delete[] msbData;
+		delete[] lsbData;
+	}
 };
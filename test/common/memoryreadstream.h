@@ -100,4 +100,29 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_read_window() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		uint32 size;
+		const byte *window = ms.getReadWindow(size);
+		TS_ASSERT_EQUALS(window, contents);
+		TS_ASSERT_EQUALS(size, 7U);
+
+		ms.consumeReadWindow(3);
+		TS_ASSERT_EQUALS(ms.pos(), 3);
+		TS_ASSERT_EQUALS(ms.readByte(), 4);
+
+		window = ms.getReadWindow(size);
+		TS_ASSERT_EQUALS(window, contents + 4);
+		TS_ASSERT_EQUALS(size, 3U);
+
+		// Reads crossing the window end fall back to read()
+		ms.seek(5, SEEK_SET);
+		ms.readUint32LE();
+		TS_ASSERT(ms.eos());
+		ms.getReadWindow(size);
+		TS_ASSERT_EQUALS(size, 0U);
+	}
 };
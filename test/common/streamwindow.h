@@ -0,0 +1,52 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/substream.h"
+
+/**
+ * Compares the read window fast path of the endian readers with the
+ * virtual read() path they fall back to. SeekableSubReadStream does not
+ * provide a window, so reading the same data through it always takes the
+ * read() path.
+ */
+class StreamWindowTestSuite : public CxxTest::TestSuite {
+	enum {
+		kDataSize = 4 * 1024
+	};
+
+	static uint32 readAll(Common::SeekableReadStream &stream) {
+		uint32 sum = 0;
+		for (int i = 0; i < kDataSize / 13; ++i) {
+			sum += stream.readByte();
+			sum ^= stream.readUint16LE();
+			sum += stream.readUint32BE();
+			sum ^= stream.readUint16BE();
+			sum += stream.readUint32LE();
+			sum = (sum << 1) | (sum >> 31);
+		}
+		return sum;
+	}
+
+	public:
+	void test_same_results() {
+		byte *data = new byte[kDataSize];
+		for (int i = 0; i < kDataSize; ++i)
+			data[i] = (byte)(i * 37 + (i >> 8));
+
+		Common::MemoryReadStream windowed(data, kDataSize);
+		Common::MemoryReadStream parent(data, kDataSize);
+		Common::SeekableSubReadStream unwindowed(&parent, 0, kDataSize);
+
+		uint32 size;
+		unwindowed.getReadWindow(size);
+		TS_ASSERT_EQUALS(size, 0U);
+
+		uint32 windowedSum = readAll(windowed);
+		uint32 unwindowedSum = readAll(unwindowed);
+
+		TS_ASSERT_EQUALS(windowedSum, unwindowedSum);
+		TS_ASSERT_EQUALS(windowed.pos(), unwindowed.pos());
+
+		delete[] data;
+	}
+};
@@ -0,0 +1,182 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+#include "common/endian.h"
+
+/**
+ * Checks crossBlit() and the paletted conversion of Surface against a per
+ * pixel colorToARGB() / ARGBToColor() conversion for a matrix of common
+ * formats.
+ */
+class ConversionTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 40,
+		kHeight = 30,
+		kFormatCount = 7
+	};
+
+	struct Format {
+		const char *name;
+		Graphics::PixelFormat format;
+	};
+
+	static const Format *getFormats() {
+		static const Format formats[kFormatCount] = {
+			{ "RGB565",   Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+			{ "RGB555",   Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) },
+			{ "ARGB1555", Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15) },
+			{ "RGB888",   Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0) },
+			{ "XRGB8888", Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0) },
+			{ "ARGB8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24) },
+			{ "RGBA8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) }
+		};
+		return formats;
+	}
+
+	static uint32 readColor(const byte *src, int bytesPerPixel) {
+		if (bytesPerPixel == 2)
+			return *(const uint16 *)src;
+		else if (bytesPerPixel == 3)
+			return READ_UINT24(src);
+		else
+			return *(const uint32 *)src;
+	}
+
+	static void writeColor(byte *dst, int bytesPerPixel, uint32 color) {
+		if (bytesPerPixel == 2)
+			*(uint16 *)dst = color;
+		else
+			*(uint32 *)dst = color;
+	}
+
+	static void fillSurface(Graphics::Surface &surface) {
+		uint32 seed = 12345;
+		for (int y = 0; y < surface.h; y++) {
+			byte *row = (byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++) {
+				seed = seed * 1103515245 + 12345;
+				row[x] = seed >> 16;
+			}
+		}
+	}
+
+	static void convertReference(Graphics::Surface &dst, const Graphics::Surface &src) {
+		for (int y = 0; y < src.h; y++) {
+			for (int x = 0; x < src.w; x++) {
+				byte a, r, g, b;
+				src.format.colorToARGB(readColor((const byte *)src.getBasePtr(x, y), src.format.bytesPerPixel), a, r, g, b);
+				writeColor((byte *)dst.getBasePtr(x, y), dst.format.bytesPerPixel, dst.format.ARGBToColor(a, r, g, b));
+			}
+		}
+	}
+
+	static bool equalSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+		for (int y = 0; y < a.h; y++) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+	public:
+	void test_cross_blit() {
+		const Format *formats = getFormats();
+
+		// Small rects are converted pixel by pixel, larger ones through a
+		// lookup table
+		const int sizes[][2] = { { 7, 3 }, { kWidth, kHeight } };
+
+		for (int s = 0; s < ARRAYSIZE(sizes); s++) {
+			const int w = sizes[s][0];
+			const int h = sizes[s][1];
+
+			for (int i = 0; i < kFormatCount; i++) {
+				Graphics::Surface src;
+				src.create(w, h, formats[i].format);
+				fillSurface(src);
+
+				for (int j = 0; j < kFormatCount; j++) {
+					if (i == j || formats[j].format.bytesPerPixel == 3)
+						continue;
+
+					Graphics::Surface dst, reference;
+					dst.create(w, h, formats[j].format);
+					reference.create(w, h, formats[j].format);
+
+					convertReference(reference, src);
+					TS_ASSERT(Graphics::crossBlit((byte *)dst.pixels, (const byte *)src.pixels, dst.pitch, src.pitch, w, h, dst.format, src.format));
+					TS_ASSERT(equalSurfaces(dst, reference));
+
+					dst.free();
+					reference.free();
+				}
+
+				src.free();
+			}
+		}
+	}
+
+	void test_convert_in_place() {
+		const Format *formats = getFormats();
+
+		// RGB565 to ARGB8888 needs to be blitted backwards
+		Graphics::Surface surface, reference;
+		surface.create(kWidth, kHeight, formats[0].format);
+		reference.create(kWidth, kHeight, formats[5].format);
+		fillSurface(surface);
+
+		convertReference(reference, surface);
+		surface.convertToInPlace(formats[5].format);
+
+		TS_ASSERT(surface.format == formats[5].format);
+		TS_ASSERT(equalSurfaces(surface, reference));
+
+		surface.free();
+		reference.free();
+	}
+
+	void test_convert_paletted() {
+		const Format *formats = getFormats();
+
+		byte palette[256 * 3];
+		for (int i = 0; i < 256 * 3; i++)
+			palette[i] = i * 7 + (i >> 3);
+
+		Graphics::Surface src;
+		src.create(kWidth, kHeight, Graphics::PixelFormat::createFormatCLUT8());
+		fillSurface(src);
+
+		const int targets[] = { 0, 4 };
+		for (int i = 0; i < ARRAYSIZE(targets); i++) {
+			const Graphics::PixelFormat &format = formats[targets[i]].format;
+
+			Graphics::Surface reference;
+			reference.create(kWidth, kHeight, format);
+
+			for (int y = 0; y < kHeight; y++) {
+				for (int x = 0; x < kWidth; x++) {
+					const byte *color = palette + *(const byte *)src.getBasePtr(x, y) * 3;
+					writeColor((byte *)reference.getBasePtr(x, y), format.bytesPerPixel, format.RGBToColor(color[0], color[1], color[2]));
+				}
+			}
+
+			Graphics::Surface *converted = src.convertTo(format, palette);
+			TS_ASSERT(equalSurfaces(*converted, reference));
+			converted->free();
+			delete converted;
+
+			Graphics::Surface inPlace;
+			inPlace.copyFrom(src);
+			inPlace.convertToInPlace(format, palette);
+			TS_ASSERT(equalSurfaces(inPlace, reference));
+			inPlace.free();
+
+			reference.free();
+		}
+
+		src.free();
+	}
+};
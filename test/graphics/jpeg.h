@@ -0,0 +1,337 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/decoders/jpeg.h"
+#include "graphics/pixelformat.h"
+
+#include "common/memstream.h"
+
+/*
+ * Baseline JPEG images of a synthetic pattern, with 4:2:0 chroma
+ * subsampling and a restart interval of 5 MCUs (100x76), and without
+ * subsampling (64x48).
+ */
+static const byte jpeg420Data[] = {
+	0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+	0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x84, 0x00, 0x05, 0x03, 0x03, 0x05, 0x07, 0x0C, 0x0F,
+	0x12, 0x04, 0x04, 0x04, 0x06, 0x08, 0x11, 0x12, 0x11, 0x04, 0x04, 0x05, 0x07, 0x0C, 0x11, 0x15,
+	0x11, 0x04, 0x05, 0x07, 0x09, 0x0F, 0x1A, 0x18, 0x13, 0x05, 0x07, 0x0B, 0x11, 0x14, 0x21, 0x1F,
+	0x17, 0x07, 0x0B, 0x11, 0x13, 0x18, 0x1F, 0x22, 0x1C, 0x0F, 0x13, 0x17, 0x1A, 0x1F, 0x24, 0x24,
+	0x1E, 0x16, 0x1C, 0x1D, 0x1D, 0x22, 0x1E, 0x1F, 0x1E, 0x01, 0x05, 0x05, 0x07, 0x0E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x05, 0x06, 0x08, 0x14, 0x1E, 0x1E, 0x1E, 0x1E, 0x07, 0x08, 0x11, 0x1E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x0E, 0x14, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00,
+	0x4C, 0x00, 0x64, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+	0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4,
+	0x00, 0xB5, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+	0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13,
+	0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15,
+	0x52, 0xD1, 0xF0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+	0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46,
+	0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66,
+	0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+	0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4,
+	0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2,
+	0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+	0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5,
+	0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00, 0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+	0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00, 0x02, 0x01, 0x02, 0x04,
+	0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11,
+	0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+	0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15, 0x62, 0x72, 0xD1, 0x0A,
+	0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35,
+	0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+	0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75,
+	0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93,
+	0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+	0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8,
+	0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6,
+	0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDD, 0x00,
+	0x04, 0x00, 0x05, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F,
+	0x00, 0xF3, 0xDF, 0x0E, 0xC0, 0xA8, 0x07, 0x02, 0xB7, 0x65, 0xBC, 0x18, 0xE0, 0xD7, 0x31, 0x05,
+	0xEE, 0xDE, 0x86, 0xAF, 0x5B, 0xDC, 0x17, 0xEF, 0x5F, 0x51, 0xC6, 0xF9, 0xF2, 0x5E, 0xE6, 0x55,
+	0xFE, 0x1D, 0x0F, 0xD8, 0xF0, 0x58, 0x94, 0x97, 0xEF, 0x64, 0x7B, 0xD5, 0x94, 0x82, 0x3A, 0x9A,
+	0xE3, 0x59, 0x00, 0x70, 0xD5, 0x83, 0x7B, 0xA8, 0x6D, 0xE8, 0x6B, 0x35, 0xF5, 0x12, 0xDD, 0xEB,
+	0xE0, 0x78, 0xBB, 0x3A, 0xFB, 0x19, 0x52, 0xFE, 0xE6, 0x87, 0xE1, 0x3C, 0x1F, 0x43, 0x97, 0xF8,
+	0xC7, 0x13, 0xA5, 0xD9, 0x84, 0xED, 0x5D, 0x56, 0x97, 0x3E, 0x3A, 0x56, 0x30, 0x87, 0x1D, 0x05,
+	0x6B, 0xE9, 0x16, 0xEC, 0x4F, 0x4A, 0xF7, 0x78, 0xEF, 0x89, 0x3F, 0xE5, 0xDE, 0x55, 0xFE, 0x0D,
+	0x0E, 0x3C, 0x9E, 0x83, 0x4E, 0xF5, 0x7D, 0x4E, 0x1F, 0x56, 0x70, 0x95, 0xCC, 0xDD, 0xEA, 0x27,
+	0x3C, 0x1A, 0xD6, 0xD7, 0xEE, 0x73, 0x9C, 0x1A, 0xE6, 0x5A, 0x36, 0x63, 0xDE, 0xBE, 0x93, 0x89,
+	0x33, 0xFF, 0x00, 0xF9, 0x77, 0x95, 0x7F, 0x83, 0x43, 0xD6, 0xCB, 0x72, 0xA7, 0xCD, 0x7A, 0x91,
+	0xF3, 0x3E, 0xBF, 0xBD, 0x80, 0x28, 0xE9, 0x58, 0x57, 0x0C, 0x73, 0xC5, 0x6E, 0xDF, 0xC9, 0xBB,
+	0xA5, 0x79, 0xC7, 0xC6, 0x1F, 0x1A, 0x36, 0x8B, 0x6D, 0xFE, 0x86, 0xC4, 0x5F, 0xCB, 0x98, 0x34,
+	0x7C, 0xA6, 0x44, 0x5B, 0x0A, 0xEE, 0x79, 0x33, 0xC7, 0xEE, 0x55, 0x86, 0x33, 0x9C, 0xB1, 0x19,
+	0x52, 0x33, 0x8F, 0xCB, 0xB3, 0xFC, 0xF6, 0x53, 0x6A, 0x96, 0x46, 0xAE, 0xDB, 0xF6, 0x51, 0xB7,
+	0xF5, 0xB2, 0xDD, 0x9F, 0x97, 0xE2, 0xF2, 0xDA, 0x95, 0x26, 0x96, 0x1E, 0x37, 0x72, 0x7C, 0xB1,
+	0xFF, 0x00, 0x3F, 0x45, 0xBB, 0xF2, 0x3F, 0xFF, 0xD0, 0xEE, 0xFE, 0x07, 0x7C, 0x3E, 0x8E, 0xCE,
+	0x1F, 0xB5, 0x6A, 0x70, 0xC4, 0x67, 0x90, 0x7F, 0xC4, 0x95, 0x1D, 0x4E, 0xED, 0x3A, 0xCF, 0xE6,
+	0x05, 0x86, 0xEC, 0x73, 0x78, 0x31, 0x82, 0x17, 0xEE, 0xF4, 0x6C, 0x31, 0x15, 0x77, 0xC5, 0xBA,
+	0x99, 0x39, 0xC1, 0xAE, 0xA7, 0xC4, 0x7A, 0xEE, 0xEC, 0xE1, 0xAB, 0x82, 0xD4, 0xD5, 0xA5, 0x35,
+	0xF1, 0xFC, 0x55, 0xC4, 0xD3, 0xA9, 0x36, 0xB0, 0x57, 0xD7, 0xDC, 0x8A, 0x5F, 0x65, 0x74, 0x5F,
+	0xD7, 0xA9, 0xF1, 0xDC, 0x4F, 0x5A, 0x75, 0xA4, 0xE7, 0x89, 0xEB, 0xF0, 0x2F, 0xE4, 0x8F, 0x44,
+	0xBD, 0x3F, 0x17, 0xAE, 0xEC, 0xF3, 0xC8, 0x11, 0x00, 0xED, 0x52, 0x61, 0x3D, 0xAB, 0x0C, 0xEA,
+	0xC3, 0xD6, 0x8F, 0xED, 0x6F, 0x7A, 0xFD, 0xB2, 0xAF, 0x10, 0xD0, 0x4D, 0xA8, 0xF2, 0xE9, 0xEE,
+	0xA3, 0xFA, 0x4F, 0xEB, 0xBF, 0xDE, 0x3E, 0x85, 0x95, 0x54, 0x0A, 0xE7, 0x75, 0x99, 0xBD, 0x2B,
+	0x42, 0x7D, 0x47, 0x3D, 0x0D, 0x64, 0x5E, 0x82, 0xF5, 0xF8, 0xF7, 0x13, 0xE7, 0xF6, 0xFD, 0xDE,
+	0x55, 0xFE, 0x0D, 0x0F, 0xC4, 0x72, 0x4C, 0xA1, 0x35, 0x7A, 0x91, 0xF3, 0x3C, 0xF3, 0x4F, 0x45,
+	0x02, 0xAF, 0x79, 0x79, 0xE8, 0x2B, 0x16, 0xC2, 0xEB, 0x3D, 0x2B, 0xAA, 0xD1, 0xAC, 0x4C, 0x9D,
+	0xAB, 0xEA, 0x78, 0xE7, 0x88, 0xED, 0xEE, 0x65, 0x5F, 0xE0, 0xD0, 0xF6, 0x72, 0xBA, 0x7C, 0xFA,
+	0xD5, 0xF5, 0x31, 0xEE, 0x75, 0x55, 0x51, 0xF7, 0xAB, 0x9E, 0xD5, 0x35, 0x6D, 0xDD, 0x0D, 0x62,
+	0xEA, 0x5A, 0xF1, 0x27, 0x86, 0xAA, 0xF6, 0xB3, 0xB4, 0x87, 0xAD, 0x7A, 0xBC, 0x53, 0x9C, 0x7D,
+	0x8C, 0xA9, 0x7F, 0x77, 0x43, 0x1E, 0x1D, 0xF7, 0x9F, 0xEF, 0x4F, 0xFF, 0xD1, 0xF4, 0x78, 0x27,
+	0x58, 0xC5, 0x49, 0xFD, 0xA7, 0xBB, 0xA1, 0xAE, 0x7E, 0xF6, 0xFC, 0xE7, 0x83, 0x56, 0xB4, 0x70,
+	0xD2, 0x1E, 0xF5, 0xF3, 0x1C, 0x65, 0x9E, 0xDF, 0xDC, 0xCA, 0xBF, 0xC3, 0xA1, 0xF9, 0x3B, 0xC7,
+	0xBB, 0xFB, 0xF2, 0x3E, 0x79, 0xB7, 0xB2, 0xBA, 0xB9, 0x91, 0x63, 0xD3, 0x2D, 0xA4, 0xB8, 0x9D,
+	0xCF, 0x93, 0x6D, 0x02, 0x75, 0x76, 0xC7, 0x72, 0x7A, 0x04, 0x19, 0x24, 0x92, 0x00, 0x1C, 0x92,
+	0x05, 0x7D, 0x2D, 0xE1, 0xBD, 0x3A, 0xDB, 0x44, 0xB5, 0x48, 0x6C, 0xA5, 0xF3, 0x36, 0xE6, 0x5B,
+	0xAB, 0x92, 0xA0, 0x1B, 0xEB, 0xA9, 0x0F, 0x2D, 0x20, 0x5F, 0xC0, 0x0C, 0x92, 0x42, 0x80, 0x09,
+	0x38, 0xCD, 0x70, 0x1F, 0x06, 0xFC, 0x12, 0xB6, 0xB1, 0x7D, 0xAB, 0x52, 0x8A, 0x26, 0x9E, 0x41,
+	0x8D, 0x15, 0x1D, 0x4E, 0xED, 0x3A, 0xCF, 0xE6, 0x05, 0x86, 0xEC, 0x73, 0x78, 0x31, 0x82, 0x17,
+	0xEE, 0xF4, 0x6C, 0x31, 0x15, 0xD2, 0xDE, 0x5F, 0x33, 0x9E, 0xA6, 0xBD, 0xBF, 0x13, 0x38, 0xA5,
+	0xD4, 0x97, 0xB1, 0xC8, 0xDF, 0xBB, 0x17, 0xCB, 0x36, 0xBE, 0xD4, 0xB6, 0xFB, 0x96, 0xDE, 0xB7,
+	0xF2, 0x3E, 0xC7, 0x8E, 0xF3, 0x9B, 0xCF, 0x93, 0x0F, 0x3F, 0x76, 0x2F, 0xF7, 0x8F, 0xF9, 0xE7,
+	0xFE, 0x4B, 0x6F, 0x5B, 0xEF, 0xA1, 0xE2, 0x51, 0xD8, 0xAC, 0x43, 0xA5, 0x56, 0x9E, 0xFB, 0x1D,
+	0x0D, 0x69, 0x6A, 0x67, 0xD2, 0xB0, 0x9E, 0x16, 0x63, 0xDE, 0xBE, 0xAF, 0x8A, 0x78, 0x89, 0xCD,
+	0xF2, 0x65, 0x7F, 0xE0, 0xD0, 0xFD, 0x73, 0x39, 0x5C, 0x9A, 0xC8, 0xFA, 0x81, 0xED, 0x94, 0x76,
+	0x14, 0x9E, 0x42, 0xFB, 0x54, 0x37, 0x37, 0xA3, 0x3D, 0x6A, 0x3F, 0xB6, 0xFB, 0xD7, 0x89, 0x3E,
+	0x27, 0xA2, 0xB4, 0x8F, 0x2E, 0x9E, 0xEA, 0x3E, 0x3E, 0x39, 0x17, 0xF7, 0x4F, 0x10, 0xBA, 0xB6,
+	0x09, 0xDA, 0xB3, 0x9A, 0x63, 0x9E, 0x2B, 0x5B, 0x52, 0x6C, 0xF4, 0xAA, 0x96, 0x7A, 0x6B, 0x39,
+	0xE8, 0x6B, 0xDA, 0xE2, 0xCE, 0x24, 0x56, 0xF6, 0x79, 0x5F, 0xF8, 0x34, 0x3E, 0x77, 0x34, 0xA0,
+	0xDC, 0xAF, 0x2F, 0x53, 0xFF, 0xD2, 0xDE, 0xF1, 0x15, 0xC2, 0xA0, 0x3C, 0x8A, 0xF2, 0x8F, 0x15,
+	0x6A, 0x87, 0x27, 0x06, 0xBB, 0x1F, 0x14, 0xEB, 0x3B, 0xB3, 0x86, 0xAF, 0x38, 0xD5, 0x95, 0xA4,
+	0x3D, 0xEB, 0xBB, 0x37, 0xCF, 0x3E, 0xC6, 0x56, 0xBF, 0xB9, 0xA1, 0xA6, 0x6B, 0x84, 0xBE, 0xB6,
+	0x3E, 0xB8, 0x11, 0x2A, 0x2F, 0x6A, 0xE7, 0x35, 0xC9, 0xFD, 0x2B, 0x4A, 0xE7, 0x51, 0xCF, 0x43,
+	0x59, 0x72, 0xDB, 0xB4, 0x87, 0xA5, 0x7E, 0x7D, 0xC4, 0xFC, 0x40, 0xEF, 0xC9, 0x95, 0xFF, 0x00,
+	0x83, 0x43, 0xCC, 0xE2, 0x1A, 0x89, 0xAD, 0x59, 0xE2, 0xE6, 0xE9, 0x50, 0x75, 0x15, 0x77, 0xE1,
+	0xDF, 0x82, 0xFF, 0x00, 0xB7, 0xAE, 0x4F, 0xDA, 0xD7, 0x75, 0x84, 0x58, 0x9F, 0x58, 0xC3, 0xE0,
+	0xCB, 0xE6, 0x06, 0xDA, 0x91, 0xE3, 0x9F, 0xDF, 0x32, 0x9C, 0xE3, 0x18, 0x50, 0x70, 0xC0, 0xE3,
+	0x3C, 0x75, 0xBC, 0xD7, 0x97, 0xD2, 0xAC, 0x5A, 0x5D, 0xBC, 0xB7, 0x13, 0xB9, 0xF2, 0x6D, 0xA0,
+	0x4E, 0xAE, 0xD8, 0xEE, 0x4F, 0x40, 0xA3, 0x24, 0x92, 0x40, 0x03, 0x92, 0x40, 0xAF, 0xA7, 0xFC,
+	0x29, 0xE1, 0x8B, 0x6D, 0x22, 0xD5, 0x21, 0xB3, 0x93, 0xCD, 0xC6, 0x65, 0xBA, 0xBA, 0x2A, 0x01,
+	0xBE, 0xBA, 0x90, 0xF2, 0xD2, 0x05, 0xFC, 0x00, 0xC9, 0x24, 0x28, 0x00, 0x93, 0x8C, 0xD7, 0xD9,
+	0xF8, 0x95, 0xC5, 0x6E, 0x2B, 0xD9, 0xE4, 0x8F, 0xDE, 0x97, 0xEE, 0xE1, 0x6F, 0xB2, 0xBA, 0xBF,
+	0xF2, 0xF3, 0xD7, 0xA3, 0x3F, 0x61, 0xE2, 0x5C, 0xDA, 0x34, 0xE9, 0xDA, 0x8C, 0xD7, 0x3C, 0x97,
+	0x2D, 0x3E, 0xF0, 0x8F, 0x59, 0x7E, 0x8B, 0xCF, 0x5E, 0x8C, 0xF9, 0x6F, 0xC3, 0xF1, 0xAA, 0x01,
+	0x5D, 0x1A, 0xDC, 0x64, 0x71, 0x5C, 0x9D, 0x8D, 0xCE, 0x3A, 0x57, 0x41, 0xA6, 0x92, 0xD5, 0xED,
+	0xF1, 0xD6, 0x7F, 0x29, 0x3E, 0x4C, 0xAA, 0xFF, 0x00, 0xCB, 0xA1, 0xE8, 0xE4, 0xF5, 0x52, 0x5F,
+	0xBD, 0x67, 0xB3, 0x43, 0x74, 0x13, 0xBD, 0x48, 0xFA, 0xAE, 0x7A, 0x1A, 0xE7, 0xEE, 0xEF, 0x8E,
+	0x78, 0x34, 0xDB, 0x7B, 0x82, 0x7A, 0x9A, 0xF8, 0x5E, 0x2F, 0xCE, 0xA5, 0x37, 0xC9, 0x95, 0x27,
+	0xFC, 0x9A, 0x1F, 0xCF, 0xDC, 0x13, 0x85, 0xE5, 0xD6, 0xB2, 0x3F, 0xFF, 0xD3, 0xE4, 0xD2, 0xDC,
+	0x0E, 0xD4, 0xBE, 0x50, 0xF4, 0xA9, 0xDE, 0x33, 0xE9, 0x49, 0xE5, 0x9F, 0x4A, 0xFB, 0xEA, 0xBC,
+	0x5B, 0x41, 0x36, 0xA3, 0xCB, 0xA7, 0xBA, 0x8F, 0xCF, 0x9E, 0x0E, 0x7E, 0x67, 0xA2, 0x5D, 0x5F,
+	0xAC, 0x43, 0xAE, 0x2B, 0x97, 0xD6, 0x7C, 0x4B, 0xE8, 0xF5, 0x5F, 0xC4, 0xFA, 0xDE, 0x33, 0x86,
+	0xAE, 0x26, 0xE7, 0x52, 0x67, 0x3D, 0x4D, 0x7C, 0x47, 0x10, 0xE6, 0xD7, 0xF7, 0x32, 0xB5, 0xFD,
+	0xDD, 0x0F, 0xB4, 0xC2, 0xD6, 0xB3, 0xF7, 0xD9, 0xEE, 0xF6, 0x96, 0x6B, 0x10, 0xE9, 0x8A, 0x95,
+	0xF5, 0x2C, 0x74, 0x34, 0xBA, 0x93, 0xE3, 0xA5, 0x64, 0x0D, 0xCC, 0x7B, 0xD7, 0xCC, 0xF1, 0x6F,
+	0x10, 0xB9, 0x7B, 0x99, 0x5F, 0xF8, 0x34, 0x3C, 0x4C, 0xC2, 0x7C, 0x9F, 0x13, 0x3C, 0x8A, 0xF2,
+	0x15, 0x8C, 0x57, 0x2D, 0xAC, 0x6A, 0x9B, 0x7A, 0x1A, 0xE8, 0xB5, 0xEB, 0xAE, 0xB8, 0x34, 0xDF,
+	0x85, 0x9F, 0x0E, 0x5B, 0x5E, 0xBB, 0x3F, 0x6C, 0x8F, 0x75, 0x84, 0x58, 0x9F, 0x58, 0xC3, 0xE0,
+	0xCB, 0xE6, 0x06, 0xDA, 0x91, 0xE3, 0x9F, 0xDF, 0x32, 0x9C, 0xE3, 0x18, 0x50, 0x70, 0xC0, 0xE3,
+	0x3F, 0xA1, 0xF1, 0x57, 0x12, 0xAB, 0x38, 0xE0, 0xDE, 0x8B, 0x49, 0x5B, 0xFA, 0xDD, 0xEC, 0x8F,
+	0xDB, 0xB1, 0x38, 0x58, 0x52, 0x8B, 0x9E, 0x31, 0xD9, 0x45, 0x7B, 0x49, 0x7F, 0x97, 0xAB, 0xD9,
+	0x79, 0x9E, 0x8B, 0xFB, 0x44, 0x78, 0xEF, 0xED, 0x12, 0x7D, 0x97, 0x4C, 0x9A, 0x45, 0x82, 0x33,
+	0xFF, 0x00, 0x13, 0xA7, 0x46, 0x1B, 0x75, 0x1B, 0xCC, 0x29, 0x0A, 0x76, 0xE7, 0x8B, 0x33, 0x9C,
+	0x82, 0xDF, 0x7B, 0xAA, 0xE5, 0x41, 0xAF, 0x1C, 0x78, 0x71, 0xD0, 0x56, 0x94, 0x71, 0xE7, 0xA0,
+	0xA9, 0xE3, 0xD2, 0xCB, 0x76, 0xAE, 0x7C, 0xFF, 0x00, 0x3C, 0x49, 0x2A, 0x39, 0x26, 0xCB, 0xDD,
+	0x93, 0x5F, 0x69, 0xF5, 0x7F, 0xD7, 0xA1, 0x79, 0x66, 0x41, 0x4E, 0x94, 0x12, 0xA5, 0x15, 0xA7,
+	0xBD, 0x27, 0xFC, 0xF2, 0xEA, 0xDF, 0xAF, 0xE0, 0xB4, 0xD9, 0x1F, 0xFF, 0xD4, 0xF5, 0x9B, 0xF9,
+	0xD4, 0x0A, 0xE4, 0xB5, 0x89, 0xB3, 0xD2, 0xAF, 0xDC, 0xEA, 0x5B, 0xBA, 0x1A, 0xA4, 0xF6, 0xC5,
+	0xFB, 0x57, 0xC9, 0x71, 0x2E, 0x7D, 0x26, 0xFD, 0x9E, 0x57, 0x7F, 0xE4, 0xD0, 0xF1, 0xF2, 0x5C,
+	0xA9, 0x49, 0x5E, 0xA4, 0x7C, 0xCE, 0x1A, 0x19, 0x94, 0x0A, 0x6B, 0x82, 0xFD, 0x2B, 0x1E, 0xD6,
+	0xF4, 0xB1, 0xE0, 0xD7, 0x57, 0xA1, 0x69, 0xA6, 0x4C, 0x64, 0x57, 0xD3, 0xF1, 0xA7, 0x10, 0x4A,
+	0x4F, 0x93, 0x2B, 0xBF, 0xF2, 0xE8, 0x7B, 0xF8, 0x47, 0xCD, 0xFC, 0x46, 0x12, 0x6B, 0x2A, 0x0F,
+	0xDE, 0xA6, 0xFF, 0x00, 0x6D, 0xAF, 0xF7, 0xAB, 0xCF, 0xAE, 0xFC, 0x44, 0x77, 0x1F, 0x9A, 0xA1,
+	0xFF, 0x00, 0x84, 0x88, 0xFF, 0x00, 0x7A, 0xBE, 0xEE, 0x79, 0xED, 0x15, 0xA4, 0x54, 0x74, 0xF7,
+	0x51, 0xE5, 0xAC, 0x54, 0xBF, 0x99, 0x9E, 0xF5, 0xA0, 0x40, 0xA8, 0x07, 0x02, 0xB6, 0xA5, 0x94,
+	0x63, 0x8A, 0xC1, 0xB0, 0x90, 0x8E, 0x86, 0xB5, 0x60, 0x39, 0xEB, 0x5F, 0x92, 0xF8, 0x81, 0x9E,
+	0xC9, 0x3E, 0x4C, 0x14, 0x5A, 0xFB, 0x27, 0xD4, 0x65, 0x8D, 0x72, 0xFB, 0xE8, 0xF9, 0xEA, 0xD2,
+	0xE8, 0x27, 0x7A, 0x92, 0x7D, 0x4F, 0x23, 0x83, 0x58, 0x12, 0xDC, 0x38, 0xE8, 0x69, 0x23, 0x99,
+	0x8F, 0x53, 0x5F, 0xA5, 0xF1, 0xCE, 0x71, 0x2F, 0x83, 0x05, 0x17, 0x1F, 0xB2, 0x7D, 0x5F, 0x02,
+	0x61, 0xD6, 0x9C, 0xE7, 0xFF, 0xD5, 0xF4, 0x7B, 0x8D, 0x5A, 0xCB, 0x4E, 0x89, 0xA4, 0xD4, 0xEE,
+	0xA2, 0xB7, 0x81, 0x07, 0x9B, 0x73, 0x3B, 0xF4, 0x8D, 0x7D, 0x80, 0xEA, 0x58, 0xE0, 0x00, 0x01,
+	0x24, 0xF0, 0x01, 0x35, 0xF3, 0x07, 0x8A, 0x3C, 0x77, 0x75, 0xAE, 0x5D, 0x3C, 0xD7, 0x6B, 0xE5,
+	0xEE, 0xC4, 0x56, 0xB6, 0xA1, 0x89, 0x16, 0x36, 0xB1, 0x8E, 0x16, 0x32, 0xDF, 0x89, 0x38, 0x00,
+	0x16, 0x24, 0x80, 0x33, 0x8A, 0xEF, 0x7F, 0x6A, 0xAD, 0x66, 0xF2, 0x28, 0xED, 0xA3, 0xB7, 0xBA,
+	0x96, 0x38, 0x24, 0x32, 0xCB, 0x7F, 0x02, 0xF4, 0xBB, 0x6B, 0x63, 0x16, 0xDF, 0x34, 0xFA, 0x46,
+	0x58, 0x9C, 0x67, 0x19, 0xC1, 0x23, 0x20, 0x63, 0xC8, 0x7C, 0x3C, 0xA0, 0x91, 0x9A, 0xF4, 0x73,
+	0x0C, 0xC1, 0xA8, 0xFF, 0x00, 0xB3, 0x2B, 0x39, 0x5E, 0x94, 0x3F, 0xBB, 0x14, 0xED, 0xF7, 0xB6,
+	0xBE, 0xEB, 0x79, 0x9E, 0x4F, 0x83, 0x99, 0x5C, 0x52, 0xF6, 0xB5, 0x9A, 0x6E, 0x57, 0x85, 0x3F,
+	0xEE, 0x45, 0x3B, 0x3F, 0x9B, 0x6B, 0xEE, 0x4B, 0xCC, 0xFA, 0xEF, 0x5A, 0xBC, 0x09, 0xDE, 0xB9,
+	0x6B, 0xAD, 0x58, 0x93, 0xC3, 0x55, 0xEF, 0x12, 0xCE, 0xD9, 0x3C, 0xD7, 0x33, 0x19, 0x24, 0xF2,
+	0x6B, 0xE4, 0xB8, 0xAF, 0x39, 0x97, 0xC1, 0x84, 0x8B, 0x8A, 0xF8, 0x4F, 0xCA, 0x72, 0xBC, 0x2F,
+	0xBD, 0x79, 0x33, 0x99, 0xD4, 0x50, 0x27, 0x4A, 0xE7, 0xAE, 0x2E, 0x09, 0x3C, 0x56, 0xE6, 0xB4,
+	0xE6, 0xB1, 0xAD, 0xE2, 0x52, 0xDC, 0x8A, 0xFA, 0xEE, 0x2E, 0xCF, 0xA6, 0xFD, 0xCC, 0x2A, 0x69,
+	0x7C, 0x27, 0xEA, 0xD9, 0xFC, 0x75, 0xBB, 0x67, 0xB5, 0xF8, 0x8E, 0xED, 0x50, 0x1C, 0x11, 0x5E,
+	0x45, 0xE2, 0xDD, 0x54, 0x92, 0x70, 0x6B, 0xBB, 0xF1, 0x65, 0xD4, 0x9C, 0xFC, 0xD5, 0xE5, 0xBA,
+	0xE1, 0x2C, 0x4E, 0xE3, 0x5E, 0x56, 0x75, 0x9C, 0x4D, 0xBE, 0x4C, 0x2A, 0x69, 0x7C, 0x27, 0xD5,
+	0x67, 0x58, 0x74, 0x7D, 0x6F, 0x0C, 0x08, 0x07, 0x41, 0x4F, 0xF2, 0x93, 0xD0, 0x55, 0x3F, 0x39,
+	0xBD, 0x68, 0xF3, 0x9B, 0xD6, 0xB9, 0x6B, 0x71, 0x12, 0x4D, 0xA8, 0xD1, 0x7A, 0x7B, 0xA8, 0xEB,
+	0x4C, 0xFF, 0xD9
+};
+
+static const byte jpeg444Data[] = {
+	0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+	0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x84, 0x00, 0x05, 0x03, 0x03, 0x05, 0x07, 0x0C, 0x0F,
+	0x12, 0x04, 0x04, 0x04, 0x06, 0x08, 0x11, 0x12, 0x11, 0x04, 0x04, 0x05, 0x07, 0x0C, 0x11, 0x15,
+	0x11, 0x04, 0x05, 0x07, 0x09, 0x0F, 0x1A, 0x18, 0x13, 0x05, 0x07, 0x0B, 0x11, 0x14, 0x21, 0x1F,
+	0x17, 0x07, 0x0B, 0x11, 0x13, 0x18, 0x1F, 0x22, 0x1C, 0x0F, 0x13, 0x17, 0x1A, 0x1F, 0x24, 0x24,
+	0x1E, 0x16, 0x1C, 0x1D, 0x1D, 0x22, 0x1E, 0x1F, 0x1E, 0x01, 0x05, 0x05, 0x07, 0x0E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x05, 0x06, 0x08, 0x14, 0x1E, 0x1E, 0x1E, 0x1E, 0x07, 0x08, 0x11, 0x1E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x0E, 0x14, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+	0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00,
+	0x30, 0x00, 0x40, 0x03, 0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+	0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4,
+	0x00, 0xB5, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+	0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13,
+	0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15,
+	0x52, 0xD1, 0xF0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+	0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46,
+	0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66,
+	0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+	0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4,
+	0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2,
+	0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+	0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5,
+	0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00, 0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+	0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00, 0x02, 0x01, 0x02, 0x04,
+	0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11,
+	0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+	0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15, 0x62, 0x72, 0xD1, 0x0A,
+	0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35,
+	0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+	0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75,
+	0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93,
+	0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+	0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8,
+	0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6,
+	0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+	0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF3, 0xDF, 0x0E, 0xC0, 0xA8,
+	0x07, 0x02, 0xBF, 0x7B, 0xA9, 0x08, 0x41, 0x74, 0x3F, 0x5F, 0xC0, 0x55, 0xF3, 0x37, 0x65, 0xBC,
+	0x18, 0xE0, 0xD7, 0xE4, 0xBC, 0x51, 0x9D, 0xEE, 0xA9, 0xCF, 0xC8, 0xF7, 0xEF, 0xA6, 0xA7, 0xB0,
+	0xD9, 0x48, 0x23, 0xAF, 0x4F, 0xD9, 0xC2, 0x0B, 0xA1, 0xFC, 0x65, 0x92, 0xC1, 0x93, 0x5C, 0x6B,
+	0x20, 0x0E, 0x1A, 0xBF, 0x2C, 0xE2, 0x7C, 0xE3, 0x75, 0x4E, 0x5E, 0x47, 0xEC, 0xD9, 0x25, 0x3E,
+	0xE7, 0x8C, 0xE9, 0x76, 0x61, 0x3B, 0x57, 0xF4, 0x55, 0x47, 0x08, 0x2E, 0x87, 0xE4, 0x70, 0x4E,
+	0xE7, 0x55, 0xA5, 0xCF, 0x8E, 0x95, 0xF8, 0x97, 0x18, 0x67, 0x9B, 0xAA, 0x73, 0xF2, 0x3E, 0xE7,
+	0x26, 0x8F, 0x73, 0x85, 0xD5, 0x9C, 0x25, 0x7E, 0xED, 0x41, 0x42, 0x0B, 0xA1, 0xF2, 0xF5, 0xE9,
+	0x36, 0xF6, 0x39, 0x9B, 0xBD, 0x44, 0xE7, 0x83, 0x5F, 0x9D, 0x71, 0x36, 0x75, 0xD2, 0x9C, 0xBC,
+	0x8F, 0xA3, 0xC9, 0xB0, 0xDD, 0xD1, 0x7A, 0x0B, 0xDD, 0xBD, 0x0D, 0x74, 0x71, 0x66, 0x75, 0xBA,
+	0xA7, 0x2F, 0x23, 0xF6, 0x0C, 0x1C, 0xED, 0xB9, 0x7A, 0xDE, 0xE0, 0xBF, 0x7A, 0xFC, 0x52, 0xBB,
+	0x9C, 0xDF, 0x53, 0xD1, 0xAB, 0x8B, 0x5D, 0xCF, 0x62, 0xBD, 0xD4, 0x36, 0xF4, 0x35, 0xF4, 0xDC,
+	0x4B, 0x9D, 0x74, 0xA7, 0x2F, 0x23, 0xF9, 0xCB, 0x29, 0xC2, 0xDB, 0x74, 0x66, 0xBE, 0xA2, 0x5B,
+	0xBD, 0x7E, 0x56, 0xE1, 0x39, 0xBE, 0xA7, 0xE8, 0xB8, 0x1A, 0x89, 0x75, 0x39, 0xA1, 0x0E, 0x3A,
+	0x0A, 0xFD, 0xBF, 0x8A, 0xB3, 0xFD, 0xD5, 0x39, 0xF9, 0x1F, 0x07, 0x47, 0x09, 0xDD, 0x1A, 0xFA,
+	0x45, 0xBB, 0x13, 0xD2, 0xBF, 0x18, 0xC4, 0x4A, 0x73, 0x7D, 0x4F, 0x77, 0x0F, 0x2B, 0x1E, 0x6F,
+	0xAF, 0xDC, 0xE7, 0x38, 0x35, 0xFB, 0xEE, 0x7F, 0x9E, 0x74, 0x84, 0xFC, 0x8E, 0x8A, 0x58, 0x0F,
+	0xEE, 0x9C, 0xCB, 0x46, 0xCC, 0x7B, 0xD7, 0xC0, 0x41, 0x4E, 0x6F, 0xA9, 0xEF, 0xE0, 0xF0, 0xB6,
+	0xE8, 0x7D, 0x91, 0x2A, 0xA8, 0x15, 0xF7, 0xB4, 0x61, 0x08, 0x2E, 0x87, 0xE4, 0xB8, 0x7A, 0x17,
+	0xE8, 0x73, 0xBA, 0xCC, 0xDE, 0x95, 0xF0, 0x7C, 0x43, 0x9E, 0x74, 0x84, 0xFC, 0x8F, 0xA4, 0xC2,
+	0xE5, 0xDD, 0xE2, 0x79, 0xAE, 0x9E, 0x8A, 0x05, 0x7E, 0xF5, 0x35, 0x08, 0x2E, 0x87, 0xB1, 0xED,
+	0xAF, 0xD4, 0xBD, 0xE5, 0xE7, 0xA0, 0xAF, 0xC8, 0xB8, 0xAB, 0x3F, 0xDD, 0x53, 0x9F, 0x91, 0xD9,
+	0x4B, 0x0B, 0x7D, 0xD1, 0x5E, 0xE7, 0x55, 0x55, 0x1F, 0x7A, 0xBF, 0x5A, 0x85, 0x28, 0x41, 0x6C,
+	0x8F, 0x0E, 0x8E, 0x21, 0xBE, 0xA7, 0x3D, 0xAA, 0x6A, 0xDB, 0xBA, 0x1A, 0xFC, 0xDF, 0x88, 0xF3,
+	0x8E, 0x94, 0xE5, 0xE4, 0x7D, 0x56, 0x5F, 0x46, 0xFB, 0xA3, 0xDC, 0x20, 0x9D, 0x63, 0x15, 0xED,
+	0xD5, 0xE4, 0x82, 0xE8, 0x7E, 0x3B, 0x5F, 0x16, 0xFB, 0x92, 0x7F, 0x69, 0xEE, 0xE8, 0x6B, 0xF1,
+	0xDE, 0x29, 0xCE, 0x77, 0x54, 0xE5, 0xE4, 0x2A, 0x75, 0xFB, 0xB1, 0x67, 0xD4, 0x73, 0xD0, 0xD7,
+	0x7F, 0x13, 0xE7, 0x5B, 0xAA, 0x72, 0xF2, 0x3E, 0xE7, 0x23, 0xC2, 0xF7, 0x46, 0x45, 0xE8, 0x2F,
+	0x5F, 0x97, 0x46, 0x53, 0x9B, 0xEA, 0x7D, 0xE4, 0x30, 0xC9, 0x2D, 0x8F, 0x30, 0xB0, 0xBA, 0xCF,
+	0x4A, 0xFE, 0x85, 0xE2, 0xFC, 0xEF, 0x75, 0x4E, 0x7E, 0x47, 0xC2, 0xE5, 0x7A, 0xEE, 0x75, 0x5A,
+	0x35, 0x89, 0x93, 0xB5, 0x7E, 0x1D, 0x88, 0x9C, 0xE6, 0xFA, 0x9F, 0x79, 0x86, 0x82, 0xB1, 0xE5,
+	0x9A, 0x96, 0xBC, 0x49, 0xE1, 0xAB, 0xFA, 0x0F, 0x89, 0x33, 0x7E, 0x94, 0xE5, 0xE4, 0x7E, 0x5F,
+	0x97, 0x79, 0x95, 0xED, 0x67, 0x69, 0x0F, 0x5A, 0xFC, 0xC1, 0xD3, 0x9C, 0xDF, 0x53, 0xF4, 0xFC,
+	0x9D, 0x1E, 0xED, 0x7B, 0x7E, 0x73, 0xC1, 0xAE, 0xCE, 0x25, 0xCE, 0xB7, 0x50, 0x97, 0x91, 0xFC,
+	0xCD, 0x88, 0xA9, 0xE6, 0x5A, 0xD1, 0xC3, 0x48, 0x7B, 0xD7, 0xE5, 0x73, 0x84, 0xE6, 0xFA, 0x85,
+	0x0C, 0x47, 0x99, 0xE3, 0x57, 0x56, 0xC1, 0x3B, 0x57, 0xF7, 0x3D, 0x1E, 0x48, 0x2E, 0x87, 0xEB,
+	0x39, 0xDC, 0x9B, 0x33, 0x9A, 0x63, 0x9E, 0x2B, 0xF3, 0x3E, 0x29, 0xCF, 0x37, 0x54, 0xE7, 0xE4,
+	0x7C, 0xAC, 0x21, 0xAE, 0xA7, 0xAF, 0xF8, 0x8A, 0xE1, 0x50, 0x1E, 0x45, 0x7D, 0x06, 0x12, 0x30,
+	0x82, 0xE8, 0x7E, 0x93, 0x99, 0xC6, 0xE7, 0x94, 0x78, 0xAB, 0x54, 0x39, 0x38, 0x35, 0xF2, 0xD9,
+	0xE6, 0x73, 0xD2, 0x12, 0xF2, 0x3E, 0x3E, 0xBD, 0x0F, 0x23, 0xEA, 0x21, 0x12, 0xA2, 0xF6, 0xA9,
+	0x9C, 0xE3, 0x05, 0xD0, 0xFB, 0x9C, 0x6C, 0xCE, 0x73, 0x5C, 0x9F, 0xD2, 0xBF, 0x34, 0xE2, 0x0C,
+	0xF3, 0xA4, 0x27, 0xE4, 0x7E, 0x7B, 0x9B, 0xC4, 0xF1, 0x53, 0x74, 0xA8, 0x3A, 0x8A, 0xFE, 0x9B,
+	0xAA, 0xE3, 0x05, 0xD0, 0xFE, 0xA1, 0xCB, 0xA2, 0x5D, 0xF8, 0x77, 0xE0, 0xBF, 0xED, 0xEB, 0x93,
+	0xF6, 0xB5, 0xDD, 0x61, 0x16, 0x27, 0xD6, 0x30, 0xF8, 0x32, 0xF9, 0x81, 0xB6, 0xA4, 0x78, 0xE7,
+	0xF7, 0xCC, 0xA7, 0x38, 0xC6, 0x14, 0x1C, 0x30, 0x38, 0xCF, 0xE2, 0x7E, 0x20, 0x71, 0x53, 0x84,
+	0x6D, 0x86, 0xA9, 0xEF, 0x4B, 0xDC, 0xA1, 0xA5, 0xED, 0xB5, 0xDF, 0x6D, 0x2F, 0xA7, 0x9D, 0xB4,
+	0x6A, 0xE7, 0x9B, 0xC6, 0x59, 0x8F, 0xB2, 0x87, 0xEE, 0x1F, 0xBF, 0x2F, 0x73, 0x0F, 0xA5, 0xED,
+	0x6B, 0x5D, 0xF6, 0xD1, 0x3D, 0x37, 0xD5, 0xAD, 0x1A, 0xB9, 0x97, 0xA9, 0x36, 0x7A, 0x57, 0xB7,
+	0xC4, 0x99, 0xEF, 0x48, 0x4F, 0xC8, 0xFC, 0x5B, 0x1D, 0x46, 0xFD, 0x0A, 0x96, 0x7A, 0x6B, 0x39,
+	0xE8, 0x6B, 0xF2, 0xCA, 0x95, 0x27, 0x37, 0xBB, 0x3C, 0x29, 0xD1, 0xB7, 0x43, 0xAE, 0xF1, 0x4E,
+	0xB3, 0xBB, 0x38, 0x6A, 0xFB, 0xAC, 0xF3, 0x38, 0xE9, 0x09, 0x79, 0x1F, 0xA0, 0x55, 0xA7, 0x73,
+	0xCE, 0x35, 0x65, 0x69, 0x0F, 0x7A, 0xF9, 0x3C, 0x2A, 0x9C, 0xDF, 0x53, 0xC6, 0xC4, 0x61, 0xFC,
+	0x8F, 0xA9, 0xEE, 0x75, 0x1C, 0xF4, 0x35, 0xC1, 0xC4, 0xD9, 0xD6, 0xEA, 0x12, 0xF2, 0x0A, 0xB5,
+	0x7B, 0xB3, 0x2E, 0x5B, 0x76, 0x90, 0xF4, 0xAF, 0xCE, 0xE8, 0x46, 0x73, 0x7A, 0xDC, 0xF8, 0xEC,
+	0xDA, 0x67, 0xCE, 0x76, 0xF3, 0x5E, 0x5F, 0x4A, 0xB1, 0x69, 0x76, 0xF2, 0xDC, 0x4E, 0xE7, 0xC9,
+	0xB6, 0x81, 0x3A, 0xBB, 0x63, 0xB9, 0x3D, 0x02, 0x8C, 0x92, 0x49, 0x00, 0x0E, 0x49, 0x02, 0xBF,
+	0xA6, 0x78, 0xB3, 0x3C, 0x8A, 0x4D, 0xD5, 0xAC, 0x92, 0x5A, 0xC9, 0xF6, 0xFE, 0xBA, 0x77, 0x3F,
+	0xA7, 0xF0, 0xF8, 0x88, 0x42, 0x2E, 0x58, 0xCA, 0xB1, 0x8A, 0x4B, 0x9A, 0x6D, 0xF4, 0xFE, 0xBA,
+	0x2D, 0xDB, 0xD1, 0x1F, 0x4F, 0xF8, 0x53, 0xC3, 0x16, 0xDA, 0x45, 0xAA, 0x43, 0x67, 0x27, 0x9B,
+	0x8C, 0xCB, 0x75, 0x74, 0x54, 0x03, 0x7D, 0x75, 0x21, 0xE5, 0xA4, 0x0B, 0xF8, 0x01, 0x92, 0x48,
+	0x50, 0x01, 0x27, 0x19, 0xAF, 0xE5, 0xDA, 0xF5, 0x2A, 0xD6, 0xA8, 0xE5, 0x5A, 0x2F, 0x5F, 0x76,
+	0x11, 0xDF, 0x95, 0x74, 0x5F, 0xAB, 0xF3, 0x6D, 0xDB, 0x53, 0xF0, 0x7E, 0x21, 0xCD, 0x65, 0x52,
+	0x4E, 0x75, 0xD5, 0xAF, 0xEE, 0xD3, 0x8D, 0xEF, 0xC9, 0x15, 0xB2, 0xFD, 0x5E, 0xD7, 0x6D, 0xBB,
+	0x2B, 0x9F, 0xFF, 0xD9
+};
+
+class JPEGTestSuite : public CxxTest::TestSuite {
+	static uint32 hashPlane(const Graphics::Surface &surface, uint32 hash = 2166136261U) {
+		for (int y = 0; y < surface.h; y++) {
+			const byte *row = (const byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++)
+				hash = (hash ^ row[x]) * 16777619U;
+		}
+		return hash;
+	}
+
+	static uint32 hashComponents(const Graphics::JPEGDecoder &jpeg) {
+		uint32 hash = hashPlane(*jpeg.getComponent(1));
+		hash = hashPlane(*jpeg.getComponent(2), hash);
+		return hashPlane(*jpeg.getComponent(3), hash);
+	}
+
+	void checkImage(const byte *data, uint32 size, uint16 w, uint16 h, uint32 componentsHash, uint32 rgbHash) {
+		Common::MemoryReadStream stream(data, size);
+		Graphics::JPEGDecoder jpeg;
+
+		TS_ASSERT(jpeg.loadStream(stream));
+		TS_ASSERT_EQUALS(jpeg.getWidth(), w);
+		TS_ASSERT_EQUALS(jpeg.getHeight(), h);
+		TS_ASSERT_EQUALS(hashComponents(jpeg), componentsHash);
+
+		const Graphics::Surface *surface = jpeg.getSurface();
+		TS_ASSERT_EQUALS(surface->w, w);
+		TS_ASSERT_EQUALS(surface->h, h);
+		TS_ASSERT_EQUALS(hashPlane(*surface), rgbHash);
+	}
+
+	public:
+	void test_decode_420() {
+		checkImage(jpeg420Data, sizeof(jpeg420Data), 100, 76, 1063136835U, 2813911529U);
+	}
+
+	void test_decode_444() {
+		checkImage(jpeg444Data, sizeof(jpeg444Data), 64, 48, 880260058U, 4016573531U);
+	}
+
+	void test_output_format() {
+		Common::MemoryReadStream stream(jpeg420Data, sizeof(jpeg420Data));
+		Graphics::JPEGDecoder jpeg;
+		TS_ASSERT(jpeg.loadStream(stream));
+
+		const Graphics::PixelFormat format565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::Surface *converted = jpeg.getSurface()->convertTo(format565);
+
+		jpeg.setOutputPixelFormat(format565);
+		const Graphics::Surface *surface = jpeg.getSurface();
+		TS_ASSERT(surface->format == format565);
+		TS_ASSERT_EQUALS(surface->w, converted->w);
+		TS_ASSERT_EQUALS(surface->h, converted->h);
+		TS_ASSERT_EQUALS(hashPlane(*surface), hashPlane(*converted));
+
+		converted->free();
+		delete converted;
+	}
+};
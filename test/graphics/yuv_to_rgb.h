@@ -0,0 +1,119 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+/**
+ * Checks the subsampled conversions against convert444() on chroma planes
+ * that were upsampled beforehand.
+ */
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 1280,
+		kHeight = 720
+	};
+
+	byte *_y, *_u, *_v;
+	byte *_fullU, *_fullV;
+
+	static uint32 hashSurface(const Graphics::Surface &surface) {
+		uint32 hash = 2166136261U;
+		for (int y = 0; y < surface.h; y++) {
+			const byte *row = (const byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++)
+				hash = (hash ^ row[x]) * 16777619U;
+		}
+		return hash;
+	}
+
+	// The chroma planes are allocated with an extra row and column, which
+	// the YUV410 interpolation reads at the right and bottom edges.
+	void fillPlanes() {
+		for (int y = 0; y < kHeight; y++)
+			for (int x = 0; x < kWidth; x++)
+				_y[y * kWidth + x] = (byte)(x * 3 + y * 5 + ((x * y) >> 4));
+
+		for (int y = 0; y <= kHeight; y++) {
+			for (int x = 0; x <= kWidth; x++) {
+				_u[y * (kWidth + 1) + x] = (byte)(x * 7 - y * 3);
+				_v[y * (kWidth + 1) + x] = (byte)(255 - x * 2 + y * 11);
+			}
+		}
+	}
+
+	// Nearest neighbour upsampling, as used by YUV420
+	void upsample420() {
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				_fullU[y * kWidth + x] = _u[(y >> 1) * (kWidth + 1) + (x >> 1)];
+				_fullV[y * kWidth + x] = _v[(y >> 1) * (kWidth + 1) + (x >> 1)];
+			}
+		}
+	}
+
+	// Bilinear upsampling, as used by YUV410
+	static byte interpolate(const byte *plane, int x, int y) {
+		int pitch = kWidth + 1;
+		int index = (y >> 2) * pitch + (x >> 2);
+		int xDiff = x & 3, yDiff = y & 3;
+
+		return (plane[index] * (4 - xDiff) * (4 - yDiff) + plane[index + 1] * xDiff * (4 - yDiff) +
+				plane[index + pitch] * yDiff * (4 - xDiff) + plane[index + pitch + 1] * xDiff * yDiff) >> 4;
+	}
+
+	void upsample410() {
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				_fullU[y * kWidth + x] = interpolate(_u, x, y);
+				_fullV[y * kWidth + x] = interpolate(_v, x, y);
+			}
+		}
+	}
+
+	void checkFormat(const Graphics::PixelFormat &format) {
+		Graphics::Surface surface, reference;
+		surface.create(kWidth, kHeight, format);
+		reference.create(kWidth, kHeight, format);
+
+		fillPlanes();
+
+		upsample420();
+		YUVToRGBMan.convert444(&reference, Graphics::YUVToRGBManager::kScaleITU, _y, _fullU, _fullV, kWidth, kHeight, kWidth, kWidth);
+		YUVToRGBMan.convert420(&surface, Graphics::YUVToRGBManager::kScaleITU, _y, _u, _v, kWidth, kHeight, kWidth, kWidth + 1);
+		TS_ASSERT_EQUALS(hashSurface(surface), hashSurface(reference));
+
+		upsample410();
+		YUVToRGBMan.convert444(&reference, Graphics::YUVToRGBManager::kScaleITU, _y, _fullU, _fullV, kWidth, kHeight, kWidth, kWidth);
+		YUVToRGBMan.convert410(&surface, Graphics::YUVToRGBManager::kScaleITU, _y, _u, _v, kWidth, kHeight, kWidth, kWidth + 1);
+		TS_ASSERT_EQUALS(hashSurface(surface), hashSurface(reference));
+
+		surface.free();
+		reference.free();
+	}
+
+	public:
+	void setUp() {
+		_y = new byte[kWidth * kHeight];
+		_u = new byte[(kWidth + 1) * (kHeight + 1)];
+		_v = new byte[(kWidth + 1) * (kHeight + 1)];
+		_fullU = new byte[kWidth * kHeight];
+		_fullV = new byte[kWidth * kHeight];
+	}
+
+	void tearDown() {
+		delete[] _y;
+		delete[] _u;
+		delete[] _v;
+		delete[] _fullU;
+		delete[] _fullV;
+	}
+
+	void test_convert_16bpp() {
+		checkFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_convert_32bpp() {
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+};
@@ -34,18 +34,13 @@
 
 namespace Video {
 
-#define PUT_PIXEL(offset, lum, u, v) \
-	if (_pixelFormat.bytesPerPixel != 1) { \
-		byte r = _clipTable[lum + (v << 1)]; \
-		byte g = _clipTable[lum - (u >> 1) - v]; \
-		byte b = _clipTable[lum + (u << 1)]; \
-		\
-		if (_pixelFormat.bytesPerPixel == 2) \
-			*((uint16 *)_curFrame.surface->pixels + offset) = _pixelFormat.RGBToColor(r, g, b); \
-		else \
-			*((uint32 *)_curFrame.surface->pixels + offset) = _pixelFormat.RGBToColor(r, g, b); \
-	} else \
-		*((byte *)_curFrame.surface->pixels + offset) = lum
+#define PUT_PIXEL(offset, color) \
+	if (_pixelFormat.bytesPerPixel == 1) \
+		*((byte *)_curFrame.surface->pixels + offset) = color; \
+	else if (_pixelFormat.bytesPerPixel == 2) \
+		*((uint16 *)_curFrame.surface->pixels + offset) = color; \
+	else \
+		*((uint32 *)_curFrame.surface->pixels + offset) = color
 
 CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec() {
 	_curFrame.surface = NULL;
@@ -178,6 +173,22 @@ const Graphics::Surface *CinepakDecoder::decodeImage(Common::SeekableReadStream
 	return _curFrame.surface;
 }
 
+void CinepakDecoder::convertCodebook(CinepakCodebook &codebook) const {
+	// Do the color conversion once per codebook entry instead of once per pixel
+	for (byte i = 0; i < 4; i++) {
+		byte lum = codebook.y[i];
+
+		if (_pixelFormat.bytesPerPixel == 1) {
+			codebook.color[i] = lum;
+		} else {
+			byte r = _clipTable[lum + (codebook.v << 1)];
+			byte g = _clipTable[lum - (codebook.u >> 1) - codebook.v];
+			byte b = _clipTable[lum + (codebook.u << 1)];
+			codebook.color[i] = _pixelFormat.RGBToColor(r, g, b);
+		}
+	}
+}
+
 void CinepakDecoder::loadCodebook(Common::SeekableReadStream *stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize) {
 	CinepakCodebook *codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook : _curFrame.strips[strip].v4_codebook;
 
@@ -211,6 +222,8 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream *stream, uint16 str
 				codebook[i].u = 0;
 				codebook[i].v = 0;
 			}
+
+			convertCodebook(codebook[i]);
 		}
 	}
 }
@@ -249,54 +262,54 @@ void CinepakDecoder::decodeVectors(Common::SeekableReadStream *stream, uint16 st
 						return;
 
 					// Get the codebook
-					CinepakCodebook codebook = _curFrame.strips[strip].v1_codebook[stream->readByte()];
-
-					PUT_PIXEL(iy[0] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 1, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 1, codebook.y[0], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[0] + 2, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 2, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 3, codebook.y[1], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[2] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 1, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 1, codebook.y[2], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[2] + 2, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 3, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 2, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 3, codebook.y[3], codebook.u, codebook.v);
+					const CinepakCodebook &codebook = _curFrame.strips[strip].v1_codebook[stream->readByte()];
+
+					PUT_PIXEL(iy[0] + 0, codebook.color[0]);
+					PUT_PIXEL(iy[0] + 1, codebook.color[0]);
+					PUT_PIXEL(iy[1] + 0, codebook.color[0]);
+					PUT_PIXEL(iy[1] + 1, codebook.color[0]);
+
+					PUT_PIXEL(iy[0] + 2, codebook.color[1]);
+					PUT_PIXEL(iy[0] + 3, codebook.color[1]);
+					PUT_PIXEL(iy[1] + 2, codebook.color[1]);
+					PUT_PIXEL(iy[1] + 3, codebook.color[1]);
+
+					PUT_PIXEL(iy[2] + 0, codebook.color[2]);
+					PUT_PIXEL(iy[2] + 1, codebook.color[2]);
+					PUT_PIXEL(iy[3] + 0, codebook.color[2]);
+					PUT_PIXEL(iy[3] + 1, codebook.color[2]);
+
+					PUT_PIXEL(iy[2] + 2, codebook.color[3]);
+					PUT_PIXEL(iy[2] + 3, codebook.color[3]);
+					PUT_PIXEL(iy[3] + 2, codebook.color[3]);
+					PUT_PIXEL(iy[3] + 3, codebook.color[3]);
 				} else if (flag & mask) {
 					if ((stream->pos() - startPos + 4) > (int32)chunkSize)
 						return;
 
-					CinepakCodebook codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[0] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 1, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 1, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[0] + 2, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 2, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 3, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[2] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 1, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 1, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[2] + 2, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 2, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 3, codebook.y[3], codebook.u, codebook.v);
+					const CinepakCodebook *codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[0] + 0, codebook->color[0]);
+					PUT_PIXEL(iy[0] + 1, codebook->color[1]);
+					PUT_PIXEL(iy[1] + 0, codebook->color[2]);
+					PUT_PIXEL(iy[1] + 1, codebook->color[3]);
+
+					codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[0] + 2, codebook->color[0]);
+					PUT_PIXEL(iy[0] + 3, codebook->color[1]);
+					PUT_PIXEL(iy[1] + 2, codebook->color[2]);
+					PUT_PIXEL(iy[1] + 3, codebook->color[3]);
+
+					codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[2] + 0, codebook->color[0]);
+					PUT_PIXEL(iy[2] + 1, codebook->color[1]);
+					PUT_PIXEL(iy[3] + 0, codebook->color[2]);
+					PUT_PIXEL(iy[3] + 1, codebook->color[3]);
+
+					codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[2] + 2, codebook->color[0]);
+					PUT_PIXEL(iy[2] + 3, codebook->color[1]);
+					PUT_PIXEL(iy[3] + 2, codebook->color[2]);
+					PUT_PIXEL(iy[3] + 3, codebook->color[3]);
 				}
 			}
 
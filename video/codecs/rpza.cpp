@@ -25,6 +25,7 @@
 #include "video/codecs/rpza.h"
 
 #include "common/debug.h"
+#include "common/rect.h"
 #include "common/system.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
@@ -37,8 +38,18 @@ RPZADecoder::RPZADecoder(uint16 width, uint16 height) : Codec() {
 	if (wMod != 0)
 		width += 4 - wMod;
 
+	// Decode straight to the screen format so that the frames do not need
+	// to be converted again before they are drawn. RPZA itself is RGB555,
+	// which is also used when the screen is paletted.
+	_pixelFormat = g_system->getScreenFormat();
+	if (_pixelFormat.bytesPerPixel == 1)
+		_pixelFormat = Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0);
+
 	_surface = new Graphics::Surface();
-	_surface->create(width, height, getPixelFormat());
+	_surface->create(width, height, _pixelFormat);
+
+	// Skipped blocks of the first frame stay black, as in RGB555
+	_surface->fillRect(Common::Rect(width, height), convertColor(0));
 }
 
 RPZADecoder::~RPZADecoder() {
@@ -46,6 +57,17 @@ RPZADecoder::~RPZADecoder() {
 	delete _surface;
 }
 
+uint32 RPZADecoder::convertColor(uint16 color) const {
+	static const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+
+	if (_pixelFormat == rgb555)
+		return color;
+
+	byte r, g, b;
+	rgb555.colorToRGB(color, r, g, b);
+	return _pixelFormat.RGBToColor(r, g, b);
+}
+
 #define ADVANCE_BLOCK() \
 	pixelPtr += 4; \
 	if (pixelPtr >= _surface->w) { \
@@ -57,13 +79,19 @@ RPZADecoder::~RPZADecoder() {
 		error("rpza block counter just went negative (this should not happen)") \
 
 #define PUT_PIXEL(color) \
-	if ((int32)blockPtr < _surface->w * _surface->h) \
-		WRITE_UINT16((uint16 *)_surface->pixels + blockPtr, color); \
+	if ((int32)blockPtr < _surface->w * _surface->h) { \
+		if (_pixelFormat.bytesPerPixel == 2) \
+			*((uint16 *)_surface->pixels + blockPtr) = color; \
+		else \
+			*((uint32 *)_surface->pixels + blockPtr) = color; \
+	} \
 	blockPtr++
 
 const Graphics::Surface *RPZADecoder::decodeImage(Common::SeekableReadStream *stream) {
 	uint16 colorA = 0, colorB = 0;
 	uint16 color4[4];
+	uint32 color;
+	uint32 convertedColor4[4];
 
 	uint32 rowPtr = 0;
 	uint32 pixelPtr = 0;
@@ -117,11 +145,12 @@ const Graphics::Surface *RPZADecoder::decodeImage(Common::SeekableReadStream *st
 			break;
 		case 0xa0: // Fill blocks with one color
 			colorA = stream->readUint16BE();
+			color = convertColor(colorA);
 			while (numBlocks--) {
 				blockPtr = rowPtr + pixelPtr;
 				for (byte pixel_y = 0; pixel_y < 4; pixel_y++) {
 					for (byte pixel_x = 0; pixel_x < 4; pixel_x++) {
-						PUT_PIXEL(colorA);
+						PUT_PIXEL(color);
 					}
 					blockPtr += rowInc;
 				}
@@ -159,13 +188,16 @@ const Graphics::Surface *RPZADecoder::decodeImage(Common::SeekableReadStream *st
 			color4[1] |= ((11 * ta + 21 * tb) >> 5);
 			color4[2] |= ((21 * ta + 11 * tb) >> 5);
 
+			for (byte i = 0; i < 4; i++)
+				convertedColor4[i] = convertColor(color4[i]);
+
 			while (numBlocks--) {
 				blockPtr = rowPtr + pixelPtr;
 				for (byte pixel_y = 0; pixel_y < 4; pixel_y++) {
 					byte index = stream->readByte();
 					for (byte pixel_x = 0; pixel_x < 4; pixel_x++) {
 						byte idx = (index >> (2 * (3 - pixel_x))) & 0x03;
-						PUT_PIXEL(color4[idx]);
+						PUT_PIXEL(convertedColor4[idx]);
 					}
 					blockPtr += rowInc;
 				}
@@ -182,7 +214,8 @@ const Graphics::Surface *RPZADecoder::decodeImage(Common::SeekableReadStream *st
 					if (pixel_y != 0 || pixel_x != 0)
 						colorA = stream->readUint16BE();
 
-					PUT_PIXEL(colorA);
+					color = convertColor(colorA);
+					PUT_PIXEL(color);
 				}
 				blockPtr += rowInc;
 			}
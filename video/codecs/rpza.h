@@ -40,10 +40,13 @@ public:
 	~RPZADecoder();
 
 	const Graphics::Surface *decodeImage(Common::SeekableReadStream *stream);
-	Graphics::PixelFormat getPixelFormat() const { return Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0); }
+	Graphics::PixelFormat getPixelFormat() const { return _pixelFormat; }
 
 private:
 	Graphics::Surface *_surface;
+	Graphics::PixelFormat _pixelFormat;
+
+	uint32 convertColor(uint16 color) const;
 };
 
 } // End of namespace Video
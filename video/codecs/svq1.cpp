@@ -51,9 +51,10 @@ SVQ1Decoder::SVQ1Decoder(uint16 width, uint16 height) {
 	_frameWidth = _frameHeight = 0;
 	_surface = 0;
 
-	_last[0] = 0;
-	_last[1] = 0;
-	_last[2] = 0;
+	for (int i = 0; i < 3; i++) {
+		_last[i] = _current[i] = 0;
+		_lastSize[i] = _currentSize[i] = 0;
+	}
 
 	// Setup Variable Length Code Tables
 	_blockType = new Common::Huffman(0, 4, s_svq1BlockTypeCodes, s_svq1BlockTypeLengths);
@@ -74,9 +75,10 @@ SVQ1Decoder::~SVQ1Decoder() {
 		delete _surface;
 	}
 
-	delete[] _last[0];
-	delete[] _last[1];
-	delete[] _last[2];
+	for (int i = 0; i < 3; i++) {
+		delete[] _last[i];
+		delete[] _current[i];
+	}
 
 	delete _blockType;
 	delete _intraMean;
@@ -190,21 +192,30 @@ const Graphics::Surface *SVQ1Decoder::decodeImage(Common::SeekableReadStream *st
 
 	// Decode Y, U and V component planes
 	for (int i = 0; i < 3; i++) {
-		uint width, height, pitch;
+		uint width, height, pitch, size;
 		if (i == 0) {
 			width = yWidth;
 			height = yHeight;
 			pitch = width;
-			current[i] = new byte[width * height];
+			size = width * height;
 		} else {
 			width = uvWidth;
 			height = uvHeight;
 			pitch = uvPitch;
 
 			// Add an extra row here. See below for more information.
-			current[i] = new byte[pitch * (height + 1)];
+			size = pitch * (height + 1);
 		}
 
+		// Reuse the planes of the frame before the last one
+		if (_currentSize[i] != size) {
+			delete[] _current[i];
+			_current[i] = new byte[size];
+			_currentSize[i] = size;
+		}
+
+		current[i] = _current[i];
+
 		if (frameType == 0) { // I Frame
 			// Keyframe (I)
 			byte *currentP = current[i];
@@ -273,10 +284,10 @@ const Graphics::Surface *SVQ1Decoder::decodeImage(Common::SeekableReadStream *st
 	// Finally, actually do the conversion ;)
 	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleFull, current[0], current[1], current[2], yWidth, yHeight, yWidth, uvPitch);
 
-	// Store the current surfaces for later and free the old ones
+	// Store the current planes for later and keep the old ones for the next frame
 	for (int i = 0; i < 3; i++) {
-		delete[] _last[i];
-		_last[i] = current[i];
+		SWAP(_last[i], _current[i]);
+		SWAP(_lastSize[i], _currentSize[i]);
 	}
 
 	return _surface;
@@ -424,6 +435,11 @@ bool SVQ1Decoder::svq1DecodeBlockNonIntra(Common::BitStream *s, byte *pixels, in
 		}
 
 		int mean = _interMean->getSymbol(*s) - 256;
+
+		// A zero mean without codebook stages leaves the prediction untouched
+		if (stages == 0 && mean == 0)
+			continue;
+
 		const uint32 *codebook = (const uint32 *)s_svq1InterCodebooks[level];
 		uint32 bitCache = s->getBits(stages * 4);
 
@@ -536,22 +552,81 @@ void SVQ1Decoder::putPixels8C(byte *block, const byte *pixels, int lineSize, int
 	}
 }
 
-static inline uint32 rndAvg32(uint32 a, uint32 b) {
-	return (a | b) - (((a ^ b) & ~0x01010101) >> 1);
+// The half pel kernels average all pixels of a machine word at once: eight
+// pixels on 64 bit hosts and four elsewhere.
+#ifdef SCUMM_64BITS
+typedef uint64 PixelWord;
+#else
+typedef uint32 PixelWord;
+#endif
+
+// Repeat a 32 bit byte mask over a whole PixelWord
+#define PIXEL_MASK(m) ((PixelWord)(m) | ((PixelWord)(m) << (sizeof(PixelWord) * 8 - 32)))
+
+static inline PixelWord readPixelWord(const byte *src) {
+	PixelWord word;
+	memcpy(&word, src, sizeof(word));
+	return word;
 }
 
-void SVQ1Decoder::putPixels8L2(byte *dst, const byte *src1, const byte *src2,
-		int dstStride, int srcStride1, int srcStride2, int h) {
+static inline void writePixelWord(byte *dst, PixelWord word) {
+	memcpy(dst, &word, sizeof(word));
+}
+
+static inline PixelWord rndAvg(PixelWord a, PixelWord b) {
+	return (a | b) - (((a ^ b) & ~PIXEL_MASK(0x01010101)) >> 1);
+}
+
+static inline void putPixelsL2(byte *dst, const byte *src1, const byte *src2,
+		int dstStride, int srcStride1, int srcStride2, int width, int h) {
 	for (int i = 0; i < h; i++) {
-		uint32 a = READ_UINT32(&src1[srcStride1 * i]);
-		uint32 b = READ_UINT32(&src2[srcStride2 * i]);
-		*((uint32 *)&dst[dstStride * i]) = rndAvg32(a, b);
-		a = READ_UINT32(&src1[srcStride1 * i + 4]);
-		b = READ_UINT32(&src2[srcStride2 * i + 4]);
-		*((uint32 *)&dst[dstStride * i + 4]) = rndAvg32(a, b);
+		for (int x = 0; x < width; x += sizeof(PixelWord))
+			writePixelWord(dst + x, rndAvg(readPixelWord(src1 + x), readPixelWord(src2 + x)));
+
+		src1 += srcStride1;
+		src2 += srcStride2;
+		dst += dstStride;
+	}
+}
+
+static inline void putPixelsXY2(byte *block, const byte *pixels, int lineSize, int width, int h) {
+	for (int x = 0; x < width; x += sizeof(PixelWord)) {
+		const byte *src = pixels + x;
+		byte *dst = block + x;
+
+		PixelWord a = readPixelWord(src);
+		PixelWord b = readPixelWord(src + 1);
+		PixelWord l0 = (a & PIXEL_MASK(0x03030303)) + (b & PIXEL_MASK(0x03030303)) + PIXEL_MASK(0x02020202);
+		PixelWord h0 = ((a & PIXEL_MASK(0xFCFCFCFC)) >> 2) + ((b & PIXEL_MASK(0xFCFCFCFC)) >> 2);
+
+		src += lineSize;
+
+		for (int i = 0; i < h; i += 2) {
+			a = readPixelWord(src);
+			b = readPixelWord(src + 1);
+			PixelWord l1 = (a & PIXEL_MASK(0x03030303)) + (b & PIXEL_MASK(0x03030303));
+			PixelWord h1 = ((a & PIXEL_MASK(0xFCFCFCFC)) >> 2) + ((b & PIXEL_MASK(0xFCFCFCFC)) >> 2);
+			writePixelWord(dst, h0 + h1 + (((l0 + l1) >> 2) & PIXEL_MASK(0x0F0F0F0F)));
+			src += lineSize;
+			dst += lineSize;
+			a = readPixelWord(src);
+			b = readPixelWord(src + 1);
+			l0 = (a & PIXEL_MASK(0x03030303)) + (b & PIXEL_MASK(0x03030303)) + PIXEL_MASK(0x02020202);
+			h0 = ((a & PIXEL_MASK(0xFCFCFCFC)) >> 2) + ((b & PIXEL_MASK(0xFCFCFCFC)) >> 2);
+			writePixelWord(dst, h0 + h1 + (((l0 + l1) >> 2) & PIXEL_MASK(0x0F0F0F0F)));
+			src += lineSize;
+			dst += lineSize;
+		}
 	}
 }
 
+#undef PIXEL_MASK
+
+void SVQ1Decoder::putPixels8L2(byte *dst, const byte *src1, const byte *src2,
+		int dstStride, int srcStride1, int srcStride2, int h) {
+	putPixelsL2(dst, src1, src2, dstStride, srcStride1, srcStride2, 8, h);
+}
+
 void SVQ1Decoder::putPixels8X2C(byte *block, const byte *pixels, int lineSize, int h) {
 	putPixels8L2(block, pixels, pixels + 1, lineSize, lineSize, lineSize, h);
 }
@@ -561,54 +636,28 @@ void SVQ1Decoder::putPixels8Y2C(byte *block, const byte *pixels, int lineSize, i
 }
 
 void SVQ1Decoder::putPixels8XY2C(byte *block, const byte *pixels, int lineSize, int h) {
-	for (int j = 0; j < 2; j++) {
-		uint32 a = READ_UINT32(pixels);
-		uint32 b = READ_UINT32(pixels + 1);
-		uint32 l0 = (a & 0x03030303UL) + (b & 0x03030303UL) + 0x02020202UL;
-		uint32 h0 = ((a & 0xFCFCFCFCUL) >> 2) + ((b & 0xFCFCFCFCUL) >> 2);
-
-		pixels += lineSize;
-
-		for (int i = 0; i < h; i += 2) {
-			a = READ_UINT32(pixels);
-			b = READ_UINT32(pixels + 1);
-			uint32 l1 = (a & 0x03030303UL) + (b & 0x03030303UL);
-			uint32 h1 = ((a & 0xFCFCFCFCUL) >> 2) + ((b & 0xFCFCFCFCUL) >> 2);
-			*((uint32 *)block) = h0 + h1 + (((l0 + l1) >> 2) & 0x0F0F0F0FUL);
-			pixels += lineSize;
-			block += lineSize;
-			a = READ_UINT32(pixels);
-			b = READ_UINT32(pixels + 1);
-			l0 = (a & 0x03030303UL) + (b & 0x03030303UL) + 0x02020202UL;
-			h0 = ((a & 0xFCFCFCFCUL) >> 2) + ((b & 0xFCFCFCFCUL) >> 2);
-			*((uint32 *)block) = h0 + h1 + (((l0 + l1) >> 2) & 0x0F0F0F0FUL);
-			pixels += lineSize;
-			block += lineSize;
-		}
-
-		pixels += 4 - lineSize * (h + 1);
-		block += 4 - lineSize * h;
-	}
+	putPixelsXY2(block, pixels, lineSize, 8, h);
 }
 
 void SVQ1Decoder::putPixels16C(byte *block, const byte *pixels, int lineSize, int h) {
-	putPixels8C(block, pixels, lineSize, h);
-	putPixels8C(block + 8, pixels + 8, lineSize, h);
+	// Full pel motion is the most common case, so copy whole rows at once
+	for (int i = 0; i < h; i++) {
+		memcpy(block, pixels, 16);
+		pixels += lineSize;
+		block += lineSize;
+	}
 }
 
 void SVQ1Decoder::putPixels16X2C(byte *block, const byte *pixels, int lineSize, int h) {
-	putPixels8X2C(block, pixels, lineSize, h);
-	putPixels8X2C(block + 8, pixels + 8, lineSize, h);
+	putPixelsL2(block, pixels, pixels + 1, lineSize, lineSize, lineSize, 16, h);
 }
 
 void SVQ1Decoder::putPixels16Y2C(byte *block, const byte *pixels, int lineSize, int h) {
-	putPixels8Y2C(block, pixels, lineSize, h);
-	putPixels8Y2C(block + 8, pixels + 8, lineSize, h);
+	putPixelsL2(block, pixels, pixels + lineSize, lineSize, lineSize, lineSize, 16, h);
 }
 
 void SVQ1Decoder::putPixels16XY2C(byte *block, const byte *pixels, int lineSize, int h) {
-	putPixels8XY2C(block, pixels, lineSize, h);
-	putPixels8XY2C(block + 8, pixels + 8, lineSize, h);
+	putPixelsXY2(block, pixels, lineSize, 16, h);
 }
 
 bool SVQ1Decoder::svq1MotionInterBlock(Common::BitStream *ss, byte *current, byte *previous, int pitch,
@@ -53,6 +53,9 @@ private:
 	uint16 _frameWidth, _frameHeight;
 
 	byte *_last[3];
+	byte *_current[3];
+	uint32 _lastSize[3];
+	uint32 _currentSize[3];
 
 	Common::Huffman *_blockType;
 	Common::Huffman *_intraMultistage[6];
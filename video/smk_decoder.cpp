@@ -31,6 +31,7 @@
 #include "common/stream.h"
 #include "common/memstream.h"
 #include "common/bitstream.h"
+#include "common/debug.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -47,6 +48,12 @@ enum SmkBlockTypes {
 	SMK_BLOCK_FILL = 3
 };
 
+// Huffman codes of up to this many bits are decoded with a single table
+// lookup, longer ones continue bit by bit from the table entry
+enum {
+	SMK_LOOKUP_BITS = 12
+};
+
 /*
  * class SmallHuffmanTree
  * A Huffman-tree to hold 8-bit values.
@@ -67,8 +74,8 @@ private:
 	uint16 _treeSize;
 	uint16 _tree[511];
 
-	uint16 _prefixtree[256];
-	byte _prefixlength[256];
+	uint16 _prefixtree[1 << SMK_LOOKUP_BITS];
+	byte _prefixlength[1 << SMK_LOOKUP_BITS];
 
 	Common::BitStream &_bs;
 };
@@ -78,7 +85,7 @@ SmallHuffmanTree::SmallHuffmanTree(Common::BitStream &bs)
 	uint32 bit = _bs.getBit();
 	assert(bit);
 
-	for (uint16 i = 0; i < 256; ++i)
+	for (uint16 i = 0; i < (1 << SMK_LOOKUP_BITS); ++i)
 		_prefixtree[i] = _prefixlength[i] = 0;
 
 	decodeTree(0, 0);
@@ -91,8 +98,8 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 	if (!_bs.getBit()) { // Leaf
 		_tree[_treeSize] = _bs.getBits(8);
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= SMK_LOOKUP_BITS) {
+			for (int i = 0; i < (1 << SMK_LOOKUP_BITS); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -104,9 +111,9 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint16 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == SMK_LOOKUP_BITS) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = SMK_LOOKUP_BITS;
 	}
 
 	uint16 r1 = decodeTree(prefix, length + 1);
@@ -119,7 +126,8 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 }
 
 uint16 SmallHuffmanTree::getCode(Common::BitStream &bs) {
-	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
+	// Past the end of the stream, the peeked bits are padded with zeros
+	uint32 peek = bs.peekBits(SMK_LOOKUP_BITS);
 	uint16 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -155,8 +163,8 @@ private:
 	uint32 *_tree;
 	uint32  _last[3];
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+	uint32 _prefixtree[1 << SMK_LOOKUP_BITS];
+	byte _prefixlength[1 << SMK_LOOKUP_BITS];
 
 	/* Used during construction */
 	Common::BitStream &_bs;
@@ -167,6 +175,9 @@ private:
 
 BigHuffmanTree::BigHuffmanTree(Common::BitStream &bs, int allocSize)
 	: _bs(bs) {
+	for (uint32 i = 0; i < (1 << SMK_LOOKUP_BITS); ++i)
+		_prefixtree[i] = _prefixlength[i] = 0;
+
 	uint32 bit = _bs.getBit();
 	if (!bit) {
 		_tree = new uint32[1];
@@ -175,9 +186,6 @@ BigHuffmanTree::BigHuffmanTree(Common::BitStream &bs, int allocSize)
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
 	_loBytes = new SmallHuffmanTree(_bs);
 	_hiBytes = new SmallHuffmanTree(_bs);
 
@@ -223,8 +231,8 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 		_tree[_treeSize] = v;
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= SMK_LOOKUP_BITS) {
+			for (int i = 0; i < (1 << SMK_LOOKUP_BITS); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -243,9 +251,9 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint32 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == SMK_LOOKUP_BITS) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = SMK_LOOKUP_BITS;
 	}
 
 	uint32 r1 = decodeTree(prefix, length + 1);
@@ -257,7 +265,8 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 }
 
 uint32 BigHuffmanTree::getCode(Common::BitStream &bs) {
-	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
+	// Past the end of the stream, the peeked bits are padded with zeros
+	uint32 peek = bs.peekBits(SMK_LOOKUP_BITS);
 	uint32 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -282,6 +291,7 @@ SmackerDecoder::SmackerDecoder(Audio::Mixer::SoundType soundType) : _soundType(s
 	_firstFrameStart = 0;
 	_frameTypes = 0;
 	_frameSizes = 0;
+	_lastFrameDecodeTime = 0;
 }
 
 SmackerDecoder::~SmackerDecoder() {
@@ -471,7 +481,11 @@ void SmackerDecoder::readNextPacket() {
 	_fileStream->read(frameData, frameDataSize);
 
 	Common::BitStream8LSB bs(new Common::MemoryReadStream(frameData, frameDataSize + 1, DisposeAfterUse::YES), true);
+
+	uint32 decodeStart = g_system->getMillis();
 	videoTrack->decodeFrame(bs);
+	_lastFrameDecodeTime = g_system->getMillis() - decodeStart;
+	debug(9, "Smacker frame %d decoded in %d ms", videoTrack->getCurFrame(), _lastFrameDecodeTime);
 
 	_fileStream->seek(startPos + frameSize);
 }
@@ -551,6 +565,18 @@ void SmackerDecoder::SmackerVideoTrack::readTrees(Common::BitStream &bs, uint32
 	_TypeTree = new BigHuffmanTree(bs, typeSize);
 }
 
+// Byte masks of the pixels a mono block row takes from its high color
+static const byte _monoMasks[16][4] = {
+	{ 0x00, 0x00, 0x00, 0x00 }, { 0xFF, 0x00, 0x00, 0x00 },
+	{ 0x00, 0xFF, 0x00, 0x00 }, { 0xFF, 0xFF, 0x00, 0x00 },
+	{ 0x00, 0x00, 0xFF, 0x00 }, { 0xFF, 0x00, 0xFF, 0x00 },
+	{ 0x00, 0xFF, 0xFF, 0x00 }, { 0xFF, 0xFF, 0xFF, 0x00 },
+	{ 0x00, 0x00, 0x00, 0xFF }, { 0xFF, 0x00, 0x00, 0xFF },
+	{ 0x00, 0xFF, 0x00, 0xFF }, { 0xFF, 0xFF, 0x00, 0xFF },
+	{ 0x00, 0x00, 0xFF, 0xFF }, { 0xFF, 0x00, 0xFF, 0xFF },
+	{ 0x00, 0xFF, 0xFF, 0xFF }, { 0xFF, 0xFF, 0xFF, 0xFF }
+};
+
 void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStream &bs) {
 	_MMapTree->reset();
 	_MClrTree->reset();
@@ -568,7 +594,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStream &bs) {
 	byte *out;
 	uint type, run, j, mode;
 	uint32 p1, p2, clr, map;
-	byte hi, lo;
+	uint32 hi4, lo4, mask;
 	uint i;
 
 	while (block < blocks) {
@@ -581,14 +607,13 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStream &bs) {
 				clr = _MClrTree->getCode(bs);
 				map = _MMapTree->getCode(bs);
 				out = (byte *)_surface->pixels + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				hi = clr >> 8;
-				lo = clr & 0xff;
+				hi4 = (clr >> 8) * 0x01010101;
+				lo4 = (clr & 0xff) * 0x01010101;
 				for (i = 0; i < 4; i++) {
+					// Select each pixel of the row from hi or lo at once
+					mask = READ_UINT32(_monoMasks[map & 0xf]);
 					for (j = 0; j < doubleY; j++) {
-						out[0] = (map & 1) ? hi : lo;
-						out[1] = (map & 2) ? hi : lo;
-						out[2] = (map & 4) ? hi : lo;
-						out[3] = (map & 8) ? hi : lo;
+						WRITE_UINT32(out, (hi4 & mask) | (lo4 & ~mask));
 						out += stride;
 					}
 					map >>= 4;
@@ -620,10 +645,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStream &bs) {
 							p1 = _FullTree->getCode(bs);
 							p2 = _FullTree->getCode(bs);
 							for (j = 0; j < doubleY; ++j) {
-								out[2] = p1 & 0xff;
-								out[3] = p1 >> 8;
-								out[0] = p2 & 0xff;
-								out[1] = p2 >> 8;
+								WRITE_LE_UINT32(out, (p1 << 16) | p2);
 								out += stride;
 							}
 						}
@@ -651,18 +673,8 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStream &bs) {
 							// http://article.gmane.org/gmane.comp.video.ffmpeg.devel/78768
 							p2 = _FullTree->getCode(bs);
 							p1 = _FullTree->getCode(bs);
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
-								out += stride;
-							}
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
+							for (j = 0; j < 2 * doubleY; ++j) {
+								WRITE_LE_UINT32(out, (p2 << 16) | p1);
 								out += stride;
 							}
 						}
@@ -682,7 +694,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStream &bs) {
 				out = (byte *)_surface->pixels + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
 				col = mode * 0x01010101;
 				for (i = 0; i < 4 * doubleY; ++i) {
-					out[0] = out[1] = out[2] = out[3] = col;
+					WRITE_UINT32(out, col);
 					out += stride;
 				}
 				++block;
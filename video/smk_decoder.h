@@ -67,6 +67,12 @@ public:
 
 	bool rewind();
 
+	/**
+	 * Return the time (in ms) it took to decode the video data of the
+	 * last frame.
+	 */
+	uint32 getLastFrameDecodeTime() const { return _lastFrameDecodeTime; }
+
 protected:
 	void readNextPacket();
 
@@ -153,6 +159,7 @@ protected:
 	uint32 *_frameSizes;
 
 private:
+	uint32 _lastFrameDecodeTime;
 
 	class SmackerAudioTrack : public AudioTrack {
 	public: